@@ -0,0 +1,34 @@
+/*!
+   ufire.co for links to documentation, examples, and libraries
+   github.com/u-fire for feature requests, bug reports, and  questions
+   questions@ufire.co to get in touch with someone
+
+   Measures several probes on one bus at the same moment. Each probe
+   needs its own I2C address, see setI2CAddress().
+ */
+
+#include <uFire_ISEGroup.h>
+
+uFire_ISE probe1;
+uFire_ISE probe2;
+uFire_ISEGroup group;
+
+void setup()
+{
+  Serial.begin(9600);
+  Wire.begin();
+
+  probe1.begin(0x3F);
+  probe2.begin(0x3E);
+  group.add(&probe1);
+  group.add(&probe2);
+}
+
+void loop()
+{
+  // one conversion window for every probe in the group
+  group.measuremV();
+
+  Serial.println((String)"t: " + group.timestamp + " mV: " + probe1.mV + ", " + probe2.mV);
+  delay(1000);
+}
@@ -0,0 +1,51 @@
+/*!
+   ufire.co for links to documentation, examples, and libraries
+   github.com/u-fire for feature requests, bug reports, and  questions
+   questions@ufire.co to get in touch with someone
+
+   Answers JSON commands for several probes on one Serial line.
+   Requires ArduinoJson. Send a line such as
+
+    tank:ph 22    pH of the probe named "tank" at 22 C
+    0x3e:o        ORP of the probe at 0x3E
+    *:ph; o       every probe at once, one conversion window
+
+   Each probe needs its own I2C address, see setI2CAddress().
+ */
+
+#include <uFire_ISE_Router.h>
+
+uFire_pH              tank;
+uFire_pH              sump;
+uFire_ORP             orp;
+uFire_ISE_Router_JSON router;
+String                line;
+
+void setup()
+{
+  Serial.begin(9600);
+  Wire.begin();
+
+  tank.begin(0x3F);
+  sump.begin(0x40);
+  orp.begin(0x3E);
+  router.add(&tank, "tank");
+  router.add(&sump, "sump");
+  router.add(&orp);
+}
+
+void loop()
+{
+  while (Serial.available())
+  {
+    char c = Serial.read();
+
+    if (c != '\n')
+    {
+      line += c;
+      continue;
+    }
+    Serial.println(router.process(line));
+    line = "";
+  }
+}
@@ -0,0 +1,43 @@
+/*!
+   ufire.co for links to documentation, examples, and libraries
+   github.com/u-fire for feature requests, bug reports, and  questions
+   questions@ufire.co to get in touch with someone
+
+   Samples a pH probe every second with temperature every 10 seconds,
+   and an ORP probe every 5 seconds, without blocking loop().
+ */
+
+#include <uFire_ISEScheduler.h>
+
+uFire_pH ph;
+uFire_ORP orp;
+uFire_ISEScheduler scheduler;
+
+void printpH(uFire_ISE *)
+{
+  Serial.println((String)"pH: " + ph.pH + " C: " + ph.tempC);
+}
+
+void printORP(uFire_ISE *)
+{
+  Serial.println((String)"ORP: " + orp.ORP);
+}
+
+void setup()
+{
+  Serial.begin(9600);
+  Wire.begin();
+
+  ph.begin(0x3F);
+  orp.begin(0x3E);
+  ph.onComplete(printpH);
+  orp.onComplete(printORP);
+
+  scheduler.add(&ph, 1000, 10000);
+  scheduler.add(&orp, 5000);
+}
+
+void loop()
+{
+  scheduler.update();
+}
@@ -33,6 +33,10 @@ void setup()
   ph.calibrateProbeLow(4.0);
   // ^ comment this line after the low calibration
 
+  // or let the library wait until the reading has settled in the buffer
+  // ph.calibrateProbeLowWhenStable(4.0);
+  // Serial.println((String)"settled in " + ph.settleTime + " ms");
+
   // Second, calibrate the high point
   // https://ufire.co/docs/uFire_ISE/api.html#calibrateprobehigh
 
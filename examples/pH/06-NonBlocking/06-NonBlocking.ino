@@ -0,0 +1,31 @@
+/*!
+   ufire.co for links to documentation, examples, and libraries
+   github.com/u-fire for feature requests, bug reports, and  questions
+   questions@ufire.co to get in touch with someone
+
+   Starts a pH measurement and keeps loop() running while the
+   device converts. update() returns true once the result is in.
+ */
+
+#include <uFire_pH.h>
+uFire_pH ph;
+
+void setup()
+{
+  Serial.begin(9600);
+  Wire.begin();
+
+  ph.begin();
+  ph.startMeasurepH();
+}
+
+void loop()
+{
+  if (ph.update())
+  {
+    Serial.println((String)"pH: " + ph.pH);
+    ph.startMeasurepH();
+  }
+
+  // do other work here, nothing above waits on the device
+}
@@ -0,0 +1,35 @@
+/*!
+   ufire.co for links to documentation, examples, and libraries
+   github.com/u-fire for feature requests, bug reports, and  questions
+   questions@ufire.co to get in touch with someone
+
+   Answers COBS framed binary requests on Serial and, once a
+   ISE_FRAME_STREAM_START frame arrives, sends every continuous
+   sample as a frame without being asked. See uFire_ISE_Frame.h
+   for the frame layout; uFire_ISE_FrameDecoder decodes the stream
+   on the other end.
+ */
+
+#include <uFire_ISE_Frame.h>
+uFire_pH       ph;
+uFire_pH_Frame frontend;
+uint8_t        output[4 * ISE_FRAME_ENCODED_SIZE];
+
+void setup()
+{
+  Serial.begin(115200);
+  Wire.begin();
+
+  frontend.begin(&ph);
+}
+
+void loop()
+{
+  while (Serial.available())
+  {
+    uint8_t c = Serial.read();
+    Serial.write(output, frontend.process(&c, 1, output, sizeof(output)));
+  }
+
+  Serial.write(output, frontend.stream(output, sizeof(output)));
+}
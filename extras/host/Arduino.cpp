@@ -0,0 +1,149 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdio.h>
+#include "Arduino.h"
+
+static uint64_t _clock_us = 0;
+static uint64_t _delay_us = 0;
+
+void delay(unsigned long ms)
+{
+  _clock_us += (uint64_t)ms * 1000;
+  _delay_us += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  _clock_us += us;
+  _delay_us += us;
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(_clock_us / 1000);
+}
+
+unsigned long micros()
+{
+  return (unsigned long)_clock_us;
+}
+
+void yield()
+{}
+
+uint64_t host_clock_us()
+{
+  return _clock_us;
+}
+
+void host_clock_advance(uint64_t us)
+{
+  _clock_us += us;
+}
+
+uint64_t host_delay_us()
+{
+  return _delay_us;
+}
+
+String::String(int v) : _s(std::to_string(v)) {}
+
+String::String(unsigned int v) : _s(std::to_string(v)) {}
+
+String::String(long v) : _s(std::to_string(v)) {}
+
+String::String(unsigned long v) : _s(std::to_string(v)) {}
+
+String::String(float v, unsigned char decimals)
+{
+  char buf[48];
+
+  snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+  _s = buf;
+}
+
+String::String(double v, unsigned char decimals)
+{
+  char buf[48];
+
+  snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+  _s = buf;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+  size_t i = _s.find(c, from);
+
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String &s, unsigned int from) const
+{
+  size_t i = _s.find(s._s, from);
+
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+String String::substring(unsigned int from) const
+{
+  return substring(from, _s.length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+  // Arduino swaps reversed bounds and clamps to the length
+  if (from > to)
+  {
+    unsigned int t = from;
+    from = to;
+    to   = t;
+  }
+  if (from >= _s.length()) return String();
+  if (to > _s.length()) to = _s.length();
+  return String(_s.substr(from, to - from));
+}
+
+void String::remove(unsigned int index)
+{
+  // Arduino passes (unsigned)-1 from a failed indexOf(), which removes nothing
+  if (index < _s.length()) _s.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+  if (index < _s.length()) _s.erase(index, count);
+}
+
+void String::trim()
+{
+  size_t first = _s.find_first_not_of(" \t\r\n");
+
+  if (first == std::string::npos)
+  {
+    _s.clear();
+    return;
+  }
+  _s = _s.substr(first, _s.find_last_not_of(" \t\r\n") - first + 1);
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Host stand-in for the parts of the Arduino core this library uses. Time
+// is virtual: delay() and bus traffic advance a clock instead of sleeping.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
+
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+void          yield();
+
+uint64_t host_clock_us();                 /*!< virtual time since start */
+void     host_clock_advance(uint64_t us); /*!< move virtual time forward */
+uint64_t host_delay_us();                 /*!< virtual time spent in delay() */
+
+class String /*! subset of the Arduino String used by the library */
+{
+public:
+
+  String() {}
+  String(const char *s) : _s(s ? s : "") {}
+  String(const std::string &s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v);
+  String(unsigned int v);
+  String(long v);
+  String(unsigned long v);
+  String(float v, unsigned char decimals=2);
+  String(double v, unsigned char decimals=2);
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return _s.length(); }
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+  bool concat(const String &s) { _s += s._s; return true; }
+  bool concat(const char *s) { _s += s; return true; }
+  bool concat(char c) { _s += c; return true; }
+  char charAt(unsigned int i) const { return i < _s.length() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  int indexOf(char c, unsigned int from=0) const;
+  int indexOf(const String &s, unsigned int from=0) const;
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  void trim();
+  long toInt() const { return atol(_s.c_str()); }
+  float toFloat() const { return atof(_s.c_str()); }
+
+  String& operator+=(const String &s) { _s += s._s; return *this; }
+  String& operator+=(const char *s) { _s += s; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  bool operator==(const String &s) const { return _s == s._s; }
+  bool operator==(const char *s) const { return _s == s; }
+  bool operator!=(const String &s) const { return _s != s._s; }
+  bool operator!=(const char *s) const { return _s != s; }
+  explicit operator bool() const { return true; }
+
+  friend String operator+(const String &a, const String &b) { return String(a._s + b._s); }
+
+private:
+
+  std::string _s;
+};
+
+#endif // ifndef HOST_ARDUINO_H
@@ -0,0 +1,149 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+bool TwoWire::attach(TwoWireDevice *device)
+{
+  if (_count >= WIRE_MAX_DEVICES) return false;
+
+  _devices[_count++] = device;
+  return true;
+}
+
+void TwoWire::detach(TwoWireDevice *device)
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_devices[i] == device)
+    {
+      _devices[i] = _devices[--_count];
+      return;
+    }
+  }
+}
+
+void TwoWire::resetCounters()
+{
+  transactions = 0;
+  bytesWritten = 0;
+  bytesRead    = 0;
+  nacks        = 0;
+  busTime      = 0;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  _address = address;
+  _tx_len  = 0;
+}
+
+size_t TwoWire::write(uint8_t b)
+{
+  if (_tx_len >= BUFFER_LENGTH) return 0;
+
+  _tx[_tx_len++] = b;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buf, size_t len)
+{
+  size_t n = 0;
+
+  while ((n < len) && write(buf[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool)
+{
+  TwoWireDevice *device = _find(_address);
+
+  transactions++;
+  if (!device)
+  {
+    // address byte is NACKed, nothing else goes out
+    nacks++;
+    _charge(0);
+    return 2;
+  }
+
+  device->receive(_tx, _tx_len);
+  bytesWritten += _tx_len;
+  _charge(_tx_len);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity)
+{
+  TwoWireDevice *device = _find(address);
+
+  transactions++;
+  _rx_len = 0;
+  _rx_pos = 0;
+  if (!device)
+  {
+    nacks++;
+    _charge(0);
+    return 0;
+  }
+
+  if (quantity > BUFFER_LENGTH) quantity = BUFFER_LENGTH;
+  while (_rx_len < quantity) _rx[_rx_len++] = device->request();
+  bytesRead += _rx_len;
+  _charge(_rx_len);
+  return _rx_len;
+}
+
+int TwoWire::available()
+{
+  return _rx_len - _rx_pos;
+}
+
+int TwoWire::read()
+{
+  if (_rx_pos >= _rx_len) return -1;
+
+  return _rx[_rx_pos++];
+}
+
+TwoWireDevice * TwoWire::_find(uint8_t address)
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_devices[i]->present() && (_devices[i]->address() == address)) return _devices[i];
+  }
+  return nullptr;
+}
+
+void TwoWire::_charge(size_t bytes)
+{
+  // START + address byte + data bytes, nine clocks per byte, + STOP
+  uint64_t bits = 1 + 9 * (1 + bytes) + 1;
+  uint64_t us   = (bits * 1000000 + _clock - 1) / _clock;
+
+  busTime += us;
+  host_clock_advance(us);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Host stand-in for the Arduino Wire library. Transfers are routed to
+// emulated devices and charged to the virtual clock at the bus speed.
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+#define WIRE_MAX_DEVICES 16
+
+class TwoWireDevice /*! something that answers on the bus */
+{
+public:
+
+  virtual ~TwoWireDevice() {}
+  virtual uint8_t address()                   = 0;
+  virtual bool    present()                   = 0;
+  virtual void    receive(const uint8_t *buf,
+                          size_t         len) = 0;
+  virtual uint8_t request()                   = 0;
+};
+
+class TwoWire
+{
+public:
+
+  uint32_t transactions = 0; /*!< START conditions issued */
+  uint32_t bytesWritten = 0; /*!< data bytes sent, excluding addresses */
+  uint32_t bytesRead    = 0; /*!< data bytes received */
+  uint32_t nacks        = 0; /*!< transfers no device acknowledged */
+  uint64_t busTime      = 0; /*!< virtual us spent on the wire */
+
+  void    begin() {}
+  void    setClock(uint32_t hz) { _clock = hz; }
+  bool    attach(TwoWireDevice *device);
+  void    detach(TwoWireDevice *device);
+  void    resetCounters();
+
+  void    beginTransmission(uint8_t address);
+  size_t  write(uint8_t b);
+  size_t  write(const uint8_t *buf,
+                size_t         len);
+  uint8_t endTransmission(bool stop=true);
+  uint8_t requestFrom(uint8_t address,
+                      uint8_t quantity);
+  int     available();
+  int     read();
+
+private:
+
+  TwoWireDevice *_devices[WIRE_MAX_DEVICES];
+  uint8_t        _count = 0;
+  uint32_t       _clock = 100000;
+  uint8_t        _address;
+  uint8_t        _tx[BUFFER_LENGTH];
+  uint8_t        _tx_len;
+  uint8_t        _rx[BUFFER_LENGTH];
+  uint8_t        _rx_len = 0;
+  uint8_t        _rx_pos = 0;
+  TwoWireDevice* _find(uint8_t address);
+  void           _charge(size_t bytes);
+};
+
+extern TwoWire Wire;
+
+#endif // ifndef HOST_WIRE_H
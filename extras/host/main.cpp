@@ -0,0 +1,510 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Runs the library against emulated probes and reports the simulated bus
+// time of each public call.
+
+#include <stdio.h>
+#if defined(__has_include)
+# if __has_include(<ArduinoJson.h>)
+#  include <ArduinoJson.h>
+# endif // if __has_include(<ArduinoJson.h>)
+#endif // if defined(__has_include)
+#include "uFire_ISE_Emulator.h"
+#include "uFire_pH.h"
+#include "uFire_ORP.h"
+#include "uFire_pH_JSON.h"
+#include "uFire_ORP_JSON.h"
+#include "uFire_pH_MP.h"
+#include "uFire_ISE_FileCache.h"
+#include "uFire_ISE_Convert.h"
+#include "uFire_ISE_Frame.h"
+#include "uFire_ISE_Router.h"
+#include "uFire_ISEGroup.h"
+#include "uFire_ISEScheduler.h"
+
+static uint64_t _start_us;
+static uint64_t _start_delay;
+
+static void begin_call()
+{
+  Wire.resetCounters();
+  _start_us    = host_clock_us();
+  _start_delay = host_delay_us();
+}
+
+static void end_call(const char *name)
+{
+  printf("%-32s %10.3f %10.3f %10.3f %6u %6u %6u %6u\n",
+         name,
+         (host_clock_us() - _start_us) / 1000.0,
+         Wire.busTime / 1000.0,
+         (host_delay_us() - _start_delay) / 1000.0,
+         (unsigned)Wire.transactions,
+         (unsigned)Wire.bytesWritten,
+         (unsigned)Wire.bytesRead,
+         (unsigned)Wire.nacks);
+}
+
+#define COST(name, call) \
+  do { begin_call(); call; end_call(name); } while (0)
+
+static int _failures = 0;
+static unsigned _completions[128];
+
+static void completed(uFire_ISE *ise)
+{
+  _completions[ise->_address]++;
+}
+
+// a failed check is printed and makes the exit status non-zero
+static void check(const char *name, bool ok)
+{
+  if (ok) return;
+  printf("FAIL %s\n", name);
+  _failures++;
+}
+
+int main(int, char **argv)
+{
+  uFire_ISE_Emulator ph_probe(ISE_PROBE_I2C);
+  uFire_ISE_Emulator orp_probe(0x3E);
+  uFire_pH  ph;
+  uFire_ORP orp;
+
+  Wire.attach(&ph_probe);
+  Wire.attach(&orp_probe);
+  Wire.begin();
+
+  ph_probe.input_mV  = 59.2;
+  orp_probe.input_mV = 220;
+  orp_probe.setEEPROM(POTENTIAL_REGISTER_ADDRESS, 245);
+
+  printf("%-32s %10s %10s %10s %6s %6s %6s %6s\n",
+         "call", "total ms", "bus ms", "delay ms", "xfers", "wr", "rd", "nack");
+
+  bool found = false;
+
+  COST("uFire_pH::begin",              found = ph.begin());
+  check("pH probe found", found);
+  COST("uFire_ISE::getVersion",        ph.getVersion());
+  COST("uFire_ISE::getFirmware",       ph.getFirmware());
+  COST("uFire_ISE::measuremV",         ph.measuremV());
+  COST("uFire_ISE::measureTemp",       ph.measureTemp());
+  COST("uFire_pH::measurepH",          ph.measurepH());
+  COST("uFire_pH::measurepH(20)",      ph.measurepH(20));
+  float legacy = ph.measurepH(60);
+  check("pHtomV passes NaN through", isnan(ph.pHtomV(NAN)));
+  check("pHtomV far out of range", fabs(ph.pHtomV(1e6) / ((7 - 1e6) * PROBE_MV_TO_PH) - 1) < 1e-4);
+  ph.useNernstSlope(true);
+  COST("uFire_pH::measurepH(60) Nernst", ph.measurepH(60));
+  printf("%-32s %.3f pH, %.3f bucketed, %.2f mV/pH\n", "  Nernst", ph.pH, legacy, ph.nernstSlope(60));
+  check("Nernst pH at 60 C", fabs(ph.pH - (7 - ph.mV * 298.15 / (PROBE_MV_TO_PH * (273.15 + 60)))) < 0.002);
+  ph.useNernstSlope(false);
+
+  // the uncalibrated probe reads its input, the reference for what follows
+  float reference_mV = ph.measuremV();
+  float reference_pH = ise_convert_pH(reference_mV, 25);
+
+  ph.onComplete(completed);
+  ph.startMeasurepH();
+  COST("uFire_pH::startMeasurepH", while (!ph.update()) delay(1));
+  ph.onComplete(nullptr);
+  check("onComplete called once", _completions[ph._address] == 1);
+  check("startMeasurepH matches the reference", fabs(ph.pH - reference_pH) < 0.002);
+
+  ph_probe.noise_mV = 2;
+  COST("uFire_ISE::measuremV(8, median)", ph.measuremV(8, ISE_FILTER_MEDIAN));
+  printf("%-32s %.3f\n", "  filtered mV", ph.mV);
+  check("median filter within 1 mV", fabs(ph.mV - reference_mV) < 1);
+  ph.setFilter(ISE_FILTER_MEAN, 8);
+  COST("uFire_ISE::setFilter mean of 8", ph.measuremV());
+  check("configured filter within 1 mV", fabs(ph.mV - reference_mV) < 1);
+  ph.setFilter(ISE_FILTER_NONE);
+
+  // an explicit filtered call must not leak into the setFilter() history
+  ph_probe.noise_mV = 0;
+  ph.setFilter(ISE_FILTER_MEAN, 1, 4);
+  for (int i = 0; i < 4; i++) ph.measuremV();
+  ph_probe.input_mV = 69.2;
+  ph.measuremV(2, ISE_FILTER_MEDIAN);
+  ph_probe.input_mV = 59.2;
+  check("explicit filter keeps setFilter history", fabs(ph.measuremV() - 59.2) < 0.01);
+  ph.setFilter(ISE_FILTER_NONE);
+  ph_probe.noise_mV = 2;
+  COST("uFire_pH::measurepHAdaptive(0.01)", ph.measurepHAdaptive(0.01));
+  printf("%-32s %.3f +/- %.4f pH from %u samples\n", "  adaptive", ph.pH, ph.pHUncertainty, ph.sampleCount);
+  // a mean of samples can be no further off than the peak noise
+  check("adaptive within tolerance", (ph.pHUncertainty <= 0.01) && (fabs(ph.pH - reference_pH) <= 2 / PROBE_MV_TO_PH));
+  ph_probe.noise_mV = 0.3;
+  float settled = NAN;
+
+  COST("uFire_pH::calibrateProbeLowWhenStable", settled = ph.calibrateProbeLowWhenStable(4.0));
+  printf("%-32s %lu ms\n", "  settled after", ph.settleTime);
+  check("probe settled", !isnan(settled));
+  ph_probe.noise_mV = 0;
+  COST("uFire_pH::calibrateSingle",    ph.calibrateSingle(6.0));
+  COST("uFire_pH::calibrateProbeLow",  ph.calibrateProbeLow(4.0));
+  COST("uFire_pH::calibrateProbeHigh", ph.calibrateProbeHigh(7.0));
+  COST("uFire_ISE::getCalibrateOffset", ph.getCalibrateOffset());
+  COST("uFire_ISE::readData",          ph.uFire_ISE::readData());
+  float bytewise = ph.mV;
+  ph.useBurstReads(true);
+  COST("uFire_ISE::readData burst",    ph.uFire_ISE::readData());
+  ph.useBurstReads(false);
+  check("burst read matches byte reads", ph.mV == bytewise);
+  COST("uFire_ISE::reset",             ph.reset());
+  COST("uFire_ISE::setDualPointCalibration", ph.setDualPointCalibration(4, 7, 4.1, 6.9));
+  COST("uFire_ISE::getCalibration",    ph.getCalibration());
+  COST("uFire_ISE::writeEEPROM",       ph.writeEEPROM(10, 1.5));
+  COST("uFire_ISE::readEEPROM",        ph.readEEPROM(10));
+
+  COST("uFire_ORP::begin",             orp.begin(0x3E));
+  COST("uFire_ORP::measureORP",        orp.measureORP());
+  COST("uFire_ORP::setProbePotential", orp.setProbePotential(250));
+
+  ise_snapshot_t snapshot;
+  uint8_t        blob[ISE_SNAPSHOT_SIZE];
+  bool           cloned = false;
+
+  COST("uFire_ISE::saveCalibration",   snapshot = ph.saveCalibration());
+  uFire_ISE::serializeCalibration(snapshot, blob, sizeof(blob));
+  if (uFire_ISE::deserializeCalibration(blob, sizeof(blob), snapshot))
+  {
+    COST("uFire_ISE::loadCalibration", cloned = orp.loadCalibration(snapshot));
+  }
+  printf("%-32s %s\n", "  calibration cloned", cloned ? "yes" : "no");
+  check("calibration cloned", cloned);
+
+  uFire_ISE restarted;
+  bool      warm = false;
+  char      cache[256];
+  const char *slash = strrchr(argv[0], '/');
+
+  // build/ next to the binary, whatever the working directory
+  snprintf(cache, sizeof(cache), "%.*sbuild", slash ? (int)(slash - argv[0] + 1) : 0, argv[0]);
+  check("cache directory set", ise_file_cache_directory(cache));
+  memset(cache, 0, sizeof(cache)); // the library keeps its own copy
+  ph.useCacheStorage(ise_file_cache_load, ise_file_cache_store);
+  restarted.useCacheStorage(ise_file_cache_load, ise_file_cache_store);
+  COST("uFire_ISE::persistCache",      ph.persistCache());
+  restarted.begin();
+  COST("uFire_ISE::warmStart",         warm = restarted.warmStart());
+  printf("%-32s %s\n", "  warm start", warm ? "yes" : "no");
+  check("warm start", warm);
+  ise_calibration_t warm_cal, cold_cal;
+
+  COST("uFire_ISE::getCalibration (warm)", warm_cal = restarted.getCalibration());
+  restarted.clearCache();
+  COST("uFire_ISE::getCalibration (cold)", cold_cal = restarted.getCalibration());
+  check("cold calibration matches warm", !memcmp(&warm_cal, &cold_cal, sizeof(warm_cal)));
+
+  uFire_ISE_SampleBuffer samples;
+  ise_sample_t           batch[8];
+  size_t                 drained = 0;
+
+  COST("uFire_pH::startContinuous",    ph.startContinuous(&samples));
+  begin_call();
+  while (samples.available() < 20)
+  {
+    delay(1);
+    ph.update();
+  }
+  ph.stopContinuous();
+  while (ph.busy())
+  {
+    delay(1);
+    ph.update();
+  }
+  end_call("  20 continuous samples");
+  while (size_t n = samples.drain(batch, 8)) drained += n;
+  printf("%-32s %u records, %u overruns\n", "  drained", (unsigned)drained, (unsigned)samples.overruns);
+  check("continuous samples drained", (drained >= 20) && !samples.overruns);
+
+  // polling must not turn update() back into a blocking call, and should
+  // pick up a conversion that finishes before the nominal time
+  uint64_t longest_poll = 0;
+
+  ph.useTaskPolling(true);
+  ph_probe.mv_latency = 150;
+  ph.startMeasuremV();
+  begin_call();
+  for (bool done = false; !done;)
+  {
+    delay(1);
+    uint64_t called = host_clock_us();
+
+    done = ph.update();
+    if (!done && (host_clock_us() - called > longest_poll)) longest_poll = host_clock_us() - called;
+  }
+  end_call("  polled conversion");
+  printf("%-32s %.3f ms\n", "  longest polling update", longest_poll / 1000.0);
+  check("polling update does not block", longest_poll < 2000);
+  check("polling finishes early", host_clock_us() - _start_us < ISE_MV_MEASURE_TIME * 1000);
+  ph_probe.mv_latency = ISE_MV_MEASURE_TIME;
+  ph.useTaskPolling(false);
+
+  // two probes share one conversion window and read what they read alone
+  uFire_ISEGroup group;
+  float          grouped[2];
+  uint64_t       together, alone;
+
+  group.add(&ph);
+  group.add(&orp);
+  begin_call();
+  group.measuremV();
+  end_call("uFire_ISEGroup::measuremV");
+  together   = host_clock_us() - _start_us;
+  grouped[0] = ph.mV;
+  grouped[1] = orp.mV;
+  begin_call();
+  ph.measuremV();
+  orp.measuremV();
+  end_call("  each alone");
+  alone = host_clock_us() - _start_us;
+  check("group reads match individual reads", (grouped[0] == ph.mV) && (grouped[1] == orp.mV));
+  check("group shares the conversion time", together < alone * 3 / 4);
+
+  // the gap comes from the timing profile, and useFirmwareTiming() settles
+  // on the standard one
+  uint64_t standard_us, fast_us;
+
+  begin_call();
+  ph.readMeasurements();
+  standard_us = host_clock_us() - _start_us;
+  ph.setTiming(ISE_TIMING_FAST);
+  check("setTiming", ph.getTiming().gap_us == ISE_TIMING_FAST.gap_us);
+  begin_call();
+  ph.readMeasurements();
+  fast_us = host_clock_us() - _start_us;
+  check("fast timing shortens the gaps", fast_us < standard_us);
+  ph.useFirmwareTiming();
+  check("useFirmwareTiming picks standard", ph.getTiming().gap_us == ISE_TIMING_STANDARD.gap_us);
+
+  // a simulated minute of pH every second with temperature every ten, and
+  // ORP every two; no update() may wait out a conversion
+  uFire_ISEScheduler scheduler;
+  uint64_t           longest_update = 0;
+
+  memset(_completions, 0, sizeof(_completions));
+  ph.onComplete(completed);
+  orp.onComplete(completed);
+  ph.useTaskPolling(true);
+  scheduler.add(&ph, 1000, 10000);
+  scheduler.add(&orp, 2000);
+  begin_call();
+  while (host_clock_us() - _start_us < 60000000ULL)
+  {
+    delay(1);
+    uint64_t called = host_clock_us();
+
+    scheduler.update();
+    if (host_clock_us() - called > longest_update) longest_update = host_clock_us() - called;
+  }
+  end_call("  scheduled minute");
+  ph.useTaskPolling(false);
+  ph.onComplete(nullptr);
+  orp.onComplete(nullptr);
+  printf("%-32s pH %u, ORP %u, longest update %.3f ms\n", "  completed",
+         _completions[ph._address], _completions[orp._address], longest_update / 1000.0);
+  check("scheduler pH and temperature count", (_completions[ph._address] >= 64) && (_completions[ph._address] <= 66));
+  check("scheduler ORP count", (_completions[orp._address] >= 29) && (_completions[orp._address] <= 30));
+  check("scheduler update does not block", longest_update < 30000);
+  while (ph.busy() || orp.busy())
+  {
+    delay(1);
+    ph.update();
+    orp.update();
+  }
+
+  static float raw_mV[4096], raw_C[4096], batch_pH[4096], batch_Eh[4096];
+  size_t       differ = 0;
+
+  for (size_t i = 0; i < 4096; i++)
+  {
+    raw_mV[i] = 400.0f - i * 0.2f;
+    raw_C[i]  = 5.0f + (i % 400) * 0.1f;
+  }
+  convert_pH(raw_mV, raw_C, batch_pH, 4096);
+  convert_Eh(raw_mV, orp.getProbePotential(), batch_Eh, 4096);
+  for (size_t i = 0; i < 4096; i++)
+  {
+    if ((batch_pH[i] != ise_convert_pH(raw_mV[i], raw_C[i])) ||
+        (batch_Eh[i] != ise_convert_Eh(raw_mV[i], orp.getProbePotential()))) differ++;
+  }
+  printf("%-32s 4096 samples, %u differ from per-sample\n", "  batch convert", (unsigned)differ);
+  check("batch convert matches per-sample", differ == 0);
+
+  uFire_pH_Frame         ph_frame;
+  uFire_ISE_FrameDecoder host;
+  uint8_t                request[ISE_FRAME_ENCODED_SIZE];
+  uint8_t                link[8 * ISE_FRAME_ENCODED_SIZE];
+  ise_frame_t            frame = { 0, ISE_PROBE_I2C, 1, NAN }; // ph, no temperature
+  size_t                 sent, streamed = 0, lost = 0;
+  uint16_t               next = 0;
+
+  ph_frame.begin(&ph);
+  COST("uFire_pH_Frame::process ph",   sent = ph_frame.process(request, ise_frame_encode(frame, request), link, sizeof(link)));
+  for (size_t i = 0; i < sent; i++)
+  {
+    if (host.push(link[i])) printf("%-32s command %u sequence %u value %.2f, %u bytes\n", "  response",
+                                   host.frame.command, host.frame.sequence, host.frame.value, (unsigned)sent);
+  }
+  frame.command = ISE_FRAME_STREAM_START;
+  ph_frame.process(request, ise_frame_encode(frame, request), link, sizeof(link));
+  begin_call();
+  while (streamed < 20)
+  {
+    delay(1);
+    sent = ph_frame.stream(link, sizeof(link));
+    for (size_t i = 0; i < sent; i++)
+    {
+      if (!host.push(link[i]) || (host.frame.command != ISE_FRAME_SAMPLE)) continue;
+      if (host.frame.sequence != next) lost++;
+      next = host.frame.sequence + 1;
+      streamed++;
+    }
+  }
+  end_call("  20 streamed frames");
+  frame.command = ISE_FRAME_STREAM_STOP;
+  ph_frame.process(request, ise_frame_encode(frame, request), link, sizeof(link));
+  while (ph.busy())
+  {
+    delay(1);
+    ph.update();
+  }
+  printf("%-32s %u frames, %u lost, %u bad\n", "  streamed", (unsigned)streamed, (unsigned)lost, (unsigned)host.errors);
+  check("frames streamed without loss", !lost && !host.errors);
+
+#if defined(ARDUINOJSON_VERSION)
+  uFire_pH_JSON  ph_json;
+  uFire_ORP_JSON orp_json;
+
+  COST("uFire_pH_JSON::begin",         ph_json.begin(&ph));
+  char           response[ISE_COMMAND_OUTPUT_SIZE];
+  String         text;
+
+  COST("uFire_pH_JSON::processJSON ph", text = ph_json.processJSON("ph"));
+  printf("%-32s %s\n", "  response", text.c_str());
+  COST("uFire_pH_JSON::processJSON pt", ph_json.processJSON("pt 25", 5, response, sizeof(response)));
+  printf("%-32s %s\n", "  response", response);
+  ph_json.processJSON("plrf", 4, response, sizeof(response));
+  printf("%-32s %s\n", "  response", response);
+  ph_json.processJSON("pc", 2, response, sizeof(response));
+  printf("%-32s %s\n", "  response", response);
+
+  static const char *reads[] = { "pt", "phrf", "phr", "plrf", "plr" };
+
+  ph.clearCache();
+  COST("uFire_pH_JSON::processJSON x5", for (const char *c : reads) ph_json.processJSON(c, strlen(c), response, sizeof(response)));
+  ph.clearCache();
+  COST("uFire_pH_JSON::processJSON batch", text = ph_json.processJSON("pt; phrf; phr; plrf; plr"));
+  printf("%-32s %s\n", "  response", text.c_str());
+
+  uFire_pH_MP ph_mp;
+  size_t      packed;
+
+  ph_mp.begin(&ph);
+  COST("uFire_pH_MP::processMP ps",    packed = ph_mp.processMP("ps", 2, response, sizeof(response)));
+  printf("%-32s", "  response");
+  for (size_t i = 0; i < packed; i++) printf(" %02x", (uint8_t)response[i]);
+  printf("\n");
+  String mp = ph_mp.processMP("ps");
+  check("MessagePack String matches buffer", (mp.length() == packed) && !memcmp(mp.c_str(), response, packed));
+  COST("uFire_ORP_JSON::begin",        orp_json.begin(&orp, 0x3E));
+  check("ORP probe kept 0x3E", orp._address == 0x3E);
+  COST("uFire_ORP_JSON::processJSON o", orp_json.processJSON("o"));
+
+  // two more pH probes next to the ones above, all behind one router
+  uFire_ISE_Emulator    tank_probe(0x40);
+  uFire_ISE_Emulator    sump_probe(0x41);
+  uFire_pH              tank;
+  uFire_pH              sump;
+  uFire_ISE_Router_JSON router;
+  char                  routed[ISE_ROUTER_OUTPUT_SIZE];
+
+  Wire.attach(&tank_probe);
+  Wire.attach(&sump_probe);
+  tank_probe.input_mV = 30;
+  sump_probe.input_mV = -45;
+  tank.begin(0x40);
+  sump.begin(0x41);
+  check("router probes added", router.add(&ph) && router.add(&tank, "tank") &&
+                                router.add(&sump, "sump") && router.add(&orp, "orp"));
+
+  COST("uFire_ISE_Router 0x40:ph",     router.process("0x40:ph", 7, routed, sizeof(routed)));
+  printf("%-32s %s\n", "  response", routed);
+  static const char *targets[] = { "63:ph", "tank:ph", "sump:ph", "orp:o" };
+  char               single[4][64];
+  size_t             asked   = 0;
+  bool               matched = true;
+
+  COST("uFire_ISE_Router x4 probes",   for (const char *t : targets) router.process(t, strlen(t), single[asked++], sizeof(single[0])));
+  COST("uFire_ISE_Router *:ph; o",     text = router.process("*:ph; o"));
+  printf("%-32s %s\n", "  response", text.c_str());
+  for (size_t i = 0; i < asked; i++)
+  {
+    size_t len = strlen(single[i]);
+
+    // {"tank":{"ph":6.49}} is in the fan-out without its outer braces
+    printf("%-32s %s\n", "  single", single[i]);
+    if (len < 2) matched = false;
+    else
+    {
+      single[i][len - 1] = '\0';
+      if (!strstr(text.c_str(), single[i] + 1)) matched = false;
+    }
+  }
+  check("router fan-out matches single requests", matched);
+  check("router rejects a second 0x3f", !router.add(&restarted));
+#endif // if defined(ARDUINOJSON_VERSION)
+
+  ph_probe.connected = false;
+  bool still = true;
+
+  COST("uFire_ISE::connected (gone)",  still = ph.connected());
+  check("disconnect detected", !still);
+
+#if defined(ISE_STATS)
+  static const char *names[ISE_CALL_COUNT] = {
+    "measuremV", "measureTemp", "measurepH", "measureORP", "calibrateSingle",
+    "calibrateProbeLow", "calibrateProbeHigh", "setDualPointCalibration",
+    "setCalibration", "getCalibrate*", "useTemperatureCompensation", "reset",
+    "readEEPROM", "writeEEPROM", "readData", "update"
+  };
+  ise_stats_t stats = ph.getStats();
+
+  printf("\nuFire_ISE stats for the pH probe: %u transactions, %u bytes written, %u read, %u NACKs, %.3f ms waiting\n",
+         (unsigned)stats.transactions, (unsigned)stats.bytes_written, (unsigned)stats.bytes_read,
+         (unsigned)stats.nacks, stats.delay_us / 1000.0);
+  for (int i = 0; i < ISE_CALL_COUNT; i++)
+  {
+    if (stats.calls[i].count) printf("  %-28s %3u calls %10.3f ms\n", names[i], (unsigned)stats.calls[i].count, stats.calls[i].time_us / 1000.0);
+  }
+#endif // if defined(ISE_STATS)
+
+  printf("\npH %.2f  mV %.2f  C %.2f  ORP %.2f  Eh %.2f\n", ph.pH, ph.mV, ph.tempC, orp.ORP, orp.Eh);
+  if (_failures) printf("%d checks failed\n", _failures);
+  return _failures ? 1 : 0;
+}
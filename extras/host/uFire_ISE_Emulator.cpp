@@ -0,0 +1,205 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISE_Emulator.h"
+
+uFire_ISE_Emulator::uFire_ISE_Emulator(uint8_t address, uint8_t version, uint8_t firmware)
+{
+  _address = address;
+  memset(_registers, 0, sizeof(_registers));
+  for (int i = 0; i < ISE_EMULATOR_EEPROM; i++) _eeprom[i] = NAN;
+
+  _registers[ISE_VERSION_REGISTER]    = version;
+  _registers[ISE_FW_VERSION_REGISTER] = firmware;
+  setRegister(ISE_CALIBRATE_SINGLE_REGISTER,   NAN);
+  setRegister(ISE_CALIBRATE_REFHIGH_REGISTER,  NAN);
+  setRegister(ISE_CALIBRATE_REFLOW_REGISTER,   NAN);
+  setRegister(ISE_CALIBRATE_READHIGH_REGISTER, NAN);
+  setRegister(ISE_CALIBRATE_READLOW_REGISTER,  NAN);
+}
+
+uint8_t uFire_ISE_Emulator::address()
+{
+  return _address;
+}
+
+bool uFire_ISE_Emulator::present()
+{
+  return connected;
+}
+
+void uFire_ISE_Emulator::receive(const uint8_t *buf, size_t len)
+{
+  if (!len) return;
+
+  _tick();
+
+  // first byte moves the register pointer, the rest are written in order
+  _pointer = buf[0];
+  for (size_t i = 1; i < len; i++)
+  {
+    if (_pointer >= ISE_EMULATOR_REGISTERS) break;
+
+    if (_pointer == ISE_TASK_REGISTER)
+    {
+      _command(buf[i]);
+    }
+    else
+    {
+      _registers[_pointer] = buf[i];
+    }
+    _pointer++;
+  }
+}
+
+uint8_t uFire_ISE_Emulator::request()
+{
+  _tick();
+  if (_pointer >= ISE_EMULATOR_REGISTERS) return 0xFF;
+
+  return _registers[_pointer++];
+}
+
+float uFire_ISE_Emulator::getRegister(uint8_t reg)
+{
+  float f;
+
+  memcpy(&f, &_registers[reg], sizeof(f));
+  return f;
+}
+
+void uFire_ISE_Emulator::setRegister(uint8_t reg, float value)
+{
+  memcpy(&_registers[reg], &value, sizeof(value));
+}
+
+float uFire_ISE_Emulator::getEEPROM(uint8_t address)
+{
+  return _eeprom[address];
+}
+
+void uFire_ISE_Emulator::setEEPROM(uint8_t address, float value)
+{
+  _eeprom[address] = value;
+}
+
+void uFire_ISE_Emulator::_command(uint8_t command)
+{
+  uint32_t latency;
+
+  switch (command)
+  {
+  case ISE_MEASURE_TEMP:
+    latency = temp_latency;
+    break;
+
+  case ISE_MEMORY_READ:
+  case ISE_MEMORY_WRITE:
+    latency = eeprom_latency;
+    break;
+
+  case ISE_I2C:
+    _address = (uint8_t)getRegister(ISE_SOLUTION_REGISTER);
+    return;
+
+  default:
+    latency = mv_latency;
+  }
+
+  _registers[ISE_TASK_REGISTER] = command;
+  _done_at = host_clock_us() + (uint64_t)latency * 1000;
+}
+
+void uFire_ISE_Emulator::_tick()
+{
+  uint8_t command = _registers[ISE_TASK_REGISTER];
+
+  if (command && (host_clock_us() >= _done_at))
+  {
+    _finish(command);
+    _registers[ISE_TASK_REGISTER] = 0;
+  }
+}
+
+void uFire_ISE_Emulator::_finish(uint8_t command)
+{
+  float solution = getRegister(ISE_SOLUTION_REGISTER);
+
+  switch (command)
+  {
+  case ISE_MEASURE_MV:
+    setRegister(ISE_MV_REGISTER, _calibrated(input_mV + _noise()));
+    break;
+
+  case ISE_MEASURE_TEMP:
+    setRegister(ISE_TEMP_REGISTER, input_tempC);
+    break;
+
+  case ISE_CALIBRATE_SINGLE:
+    setRegister(ISE_CALIBRATE_SINGLE_REGISTER, solution - input_mV);
+    break;
+
+  case ISE_CALIBRATE_LOW:
+    setRegister(ISE_CALIBRATE_REFLOW_REGISTER,  solution);
+    setRegister(ISE_CALIBRATE_READLOW_REGISTER, input_mV);
+    break;
+
+  case ISE_CALIBRATE_HIGH:
+    setRegister(ISE_CALIBRATE_REFHIGH_REGISTER,  solution);
+    setRegister(ISE_CALIBRATE_READHIGH_REGISTER, input_mV);
+    break;
+
+  case ISE_MEMORY_READ:
+    setRegister(ISE_BUFFER_REGISTER, _eeprom[(uint8_t)solution]);
+    break;
+
+  case ISE_MEMORY_WRITE:
+    _eeprom[(uint8_t)solution] = getRegister(ISE_BUFFER_REGISTER);
+    break;
+  }
+}
+
+float uFire_ISE_Emulator::_noise()
+{
+  // fixed seed so runs are repeatable
+  _seed = _seed * 1103515245 + 12345;
+  return noise_mV * (((_seed >> 16) & 0x7FFF) / 16383.5f - 1);
+}
+
+float uFire_ISE_Emulator::_calibrated(float raw)
+{
+  float refLow   = getRegister(ISE_CALIBRATE_REFLOW_REGISTER);
+  float refHigh  = getRegister(ISE_CALIBRATE_REFHIGH_REGISTER);
+  float readLow  = getRegister(ISE_CALIBRATE_READLOW_REGISTER);
+  float readHigh = getRegister(ISE_CALIBRATE_READHIGH_REGISTER);
+  float offset   = getRegister(ISE_CALIBRATE_SINGLE_REGISTER);
+
+  if (!isnan(refLow) && !isnan(refHigh) && !isnan(readLow) && !isnan(readHigh) && (readHigh != readLow))
+  {
+    return (raw - readLow) * (refHigh - refLow) / (readHigh - readLow) + refLow;
+  }
+  if (!isnan(offset)) return raw + offset;
+
+  return raw;
+}
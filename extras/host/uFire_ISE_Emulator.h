@@ -0,0 +1,79 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Emulated ISE probe interface. It implements the register map and task
+// commands from uFire_ISE.h against the host virtual clock.
+
+#ifndef ISE_EMULATOR_H
+#define ISE_EMULATOR_H
+
+#include "Wire.h"
+#include "uFire_ISE.h"
+
+#define ISE_EMULATOR_REGISTERS (ISE_TASK_REGISTER + 1)
+#define ISE_EMULATOR_EEPROM 256
+
+class uFire_ISE_Emulator : public TwoWireDevice /*! emulated probe */
+{
+public:
+
+  float    input_mV       = 0;                     /*!< raw mV the electrode presents */
+  float    input_tempC    = 25;                    /*!< temperature the sensor presents */
+  float    noise_mV       = 0;                     /*!< peak uniform noise added to each mV conversion */
+  uint32_t mv_latency     = ISE_MV_MEASURE_TIME;   /*!< mV conversion time in ms */
+  uint32_t temp_latency   = ISE_TEMP_MEASURE_TIME; /*!< temperature conversion time in ms */
+  uint32_t eeprom_latency = 4;                     /*!< EEPROM access time in ms */
+  bool     connected      = true;                  /*!< false makes the probe vanish from the bus */
+
+  uFire_ISE_Emulator(uint8_t address=ISE_PROBE_I2C,
+                     uint8_t version=2,
+                     uint8_t firmware=3);
+  uint8_t address();
+  bool    present();
+  void    receive(const uint8_t *buf,
+                  size_t         len);
+  uint8_t request();
+  float   getRegister(uint8_t reg);
+  void    setRegister(uint8_t reg,
+                      float   value);
+  float   getEEPROM(uint8_t address);
+  void    setEEPROM(uint8_t address,
+                    float   value);
+
+private:
+
+  uint8_t  _address;
+  uint8_t  _registers[ISE_EMULATOR_REGISTERS];
+  float    _eeprom[ISE_EMULATOR_EEPROM];
+  uint8_t  _pointer = 0;
+  uint64_t _done_at = 0;
+  uint32_t _seed    = 1;
+  float    _noise();
+  void     _command(uint8_t command);
+  void     _tick();
+  void     _finish(uint8_t command);
+  float    _calibrated(float raw);
+};
+
+#endif // ifndef ISE_EMULATOR_H
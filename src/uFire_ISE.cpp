@@ -29,23 +29,101 @@ bool uFire_ISE::begin(uint8_t address, TwoWire &wirePort)
 {
   _address = address;
   _i2cPort = &wirePort;
+  clearCache();
 
   return connected();
 }
 
 float uFire_ISE::measuremV()
 {
+  ISE_STAT_CALL(ISE_CALL_MEASURE_MV);
+  return _measuremV(_filter_samples, _filter, _filter_window, _history);
+}
+
+float uFire_ISE::measuremV(uint8_t samples, ise_filter_t filter)
+{
+  ISE_STAT_CALL(ISE_CALL_MEASURE_MV);
+  ise_filter_history_t history = {};
+
+  if (!samples) samples = 1;
+
+  // an explicit call filters only its own samples and leaves the
+  // setFilter() history alone
+  return _measuremV(samples, filter, samples < ISE_FILTER_SIZE ? samples : ISE_FILTER_SIZE, history);
+}
+
+float uFire_ISE::_measuremV(uint8_t samples, ise_filter_t filter, uint8_t window, ise_filter_history_t &history)
+{
+  uint8_t valid = 0;
+
   _send_command(ISE_MEASURE_MV);
-  if(_blocking) delay(ISE_MV_MEASURE_TIME);
-  _updateRegisters();
+  for (uint8_t i = 0; i < samples; i++)
+  {
+    if(_blocking) _wait(_timing.mv_time);
+    _updateRegisters();
+
+    // a failed conversion reads as -1 and is kept out of the filter
+    if ((filter != ISE_FILTER_NONE) && (mV != -1))
+    {
+      _filter_push(history, mV);
+      valid++;
+    }
+
+    // the next conversion starts as soon as this one has been read
+    if (i + 1 < samples) _send_command(ISE_MEASURE_MV, false);
+  }
+  if (valid) mV = _filter_value(history, filter, window);
 
   return mV;
 }
 
+float uFire_ISE::measuremVAdaptive(float tolerance, uint8_t max_samples, uint8_t min_samples)
+{
+  ISE_STAT_CALL(ISE_CALL_MEASURE_MV);
+  float   mean = 0;
+  float   m2   = 0;
+  uint8_t n    = 0;
+
+  if (min_samples < 2) min_samples = 2;
+  if (max_samples < min_samples) max_samples = min_samples;
+
+  // Welford's running mean and variance; stop once the standard error of
+  // the mean is inside the tolerance
+  uncertainty = INFINITY;
+  _send_command(ISE_MEASURE_MV);
+  for (uint8_t attempt = 1; ; attempt++)
+  {
+    if(_blocking) _wait(_timing.mv_time);
+    _updateRegisters();
+
+    // a failed conversion reads as -1 and is not a sample; it still uses
+    // up an attempt so a dead probe cannot keep the loop going
+    if (mV != -1)
+    {
+      float delta = mV - mean;
+
+      n++;
+      mean += delta / n;
+      m2   += delta * (mV - mean);
+      if (n >= 2) uncertainty = sqrt(m2 / (n - 1) / n);
+
+      if ((n >= min_samples) && (uncertainty <= tolerance)) break;
+    }
+
+    if (attempt >= max_samples) break;
+    _send_command(ISE_MEASURE_MV, false);
+  }
+
+  sampleCount = n;
+  mV          = n ? mean : -1;
+  return mV;
+}
+
 float uFire_ISE::measureTemp()
 {
+  ISE_STAT_CALL(ISE_CALL_MEASURE_TEMP);
   _send_command(ISE_MEASURE_TEMP);
-  if(_blocking) delay(ISE_TEMP_MEASURE_TIME);
+  if(_blocking) _wait(_timing.temp_time);
   _updateRegisters();
 
   return tempC;
@@ -61,69 +139,261 @@ void uFire_ISE::setTemp(float temp_C)
 
 float uFire_ISE::calibrateSingle(float solutionmV)
 {
+  ISE_STAT_CALL(ISE_CALL_CALIBRATE_SINGLE);
   _write_register(ISE_SOLUTION_REGISTER, solutionmV);
   _send_command(ISE_CALIBRATE_SINGLE);
-  if(_blocking) delay(ISE_MV_MEASURE_TIME);
+  if(_blocking) _wait(_timing.mv_time);
 
   return getCalibrateOffset();
 }
 
 float uFire_ISE::calibrateProbeLow(float solutionmV)
 {
+  ISE_STAT_CALL(ISE_CALL_CALIBRATE_LOW);
   _write_register(ISE_SOLUTION_REGISTER, solutionmV);
   _send_command(ISE_CALIBRATE_LOW);
-  if(_blocking) delay(ISE_MV_MEASURE_TIME);
+  if(_blocking) _wait(_timing.mv_time);
 
   return getCalibrateLowReading();
 }
 
 float uFire_ISE::calibrateProbeHigh(float solutionmV)
 {
+  ISE_STAT_CALL(ISE_CALL_CALIBRATE_HIGH);
   _write_register(ISE_SOLUTION_REGISTER, solutionmV);
   _send_command(ISE_CALIBRATE_HIGH);
-  if(_blocking) delay(ISE_MV_MEASURE_TIME);
+  if(_blocking) _wait(_timing.mv_time);
 
   return getCalibrateHighReading();
 }
 
+float uFire_ISE::calibrateSingleWhenStable(float solutionmV, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateSingle(solutionmV);
+}
+
+float uFire_ISE::calibrateProbeLowWhenStable(float solutionmV, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateProbeLow(solutionmV);
+}
+
+float uFire_ISE::calibrateProbeHighWhenStable(float solutionmV, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateProbeHigh(solutionmV);
+}
+
+bool uFire_ISE::waitStable(unsigned long timeout, float slope, float noise)
+{
+  float         v[ISE_STABLE_WINDOW];
+  float         t[ISE_STABLE_WINDOW];
+  uint8_t       n     = 0;
+  unsigned long start = millis();
+
+  // settled means the least squares drift over the window and the spread
+  // around its mean are both inside the limits
+  while (millis() - start < timeout)
+  {
+    // a failed conversion reads a constant -1, which would look settled
+    if (measuremV(1, ISE_FILTER_NONE) == -1) break;
+
+    if (n == ISE_STABLE_WINDOW)
+    {
+      memmove(v, v + 1, sizeof(v) - sizeof(v[0]));
+      memmove(t, t + 1, sizeof(t) - sizeof(t[0]));
+      n--;
+    }
+    v[n] = mV;
+    t[n] = (millis() - start) / 1000.0;
+    n++;
+    if (n < ISE_STABLE_WINDOW) continue;
+
+    float mean_t = 0;
+    float mean_v = 0;
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+      mean_t += t[i];
+      mean_v += v[i];
+    }
+    mean_t /= n;
+    mean_v /= n;
+
+    float stt = 0;
+    float stv = 0;
+    float svv = 0;
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+      stt += (t[i] - mean_t) * (t[i] - mean_t);
+      stv += (t[i] - mean_t) * (v[i] - mean_v);
+      svv += (v[i] - mean_v) * (v[i] - mean_v);
+    }
+
+    if ((fabs(stv / stt) <= slope) && (sqrt(svv / (n - 1)) <= noise))
+    {
+      settleTime = millis() - start;
+      return true;
+    }
+  }
+
+  settleTime = millis() - start;
+  return false;
+}
+
 void uFire_ISE::setDualPointCalibration(float refLow,
                                         float refHigh,
                                         float readLow,
                                         float readHigh)
 {
-  _write_register(ISE_CALIBRATE_REFLOW_REGISTER,   refLow);
-  _write_register(ISE_CALIBRATE_REFHIGH_REGISTER,  refHigh);
-  _write_register(ISE_CALIBRATE_READLOW_REGISTER,  readLow);
-  _write_register(ISE_CALIBRATE_READHIGH_REGISTER, readHigh);
+  ISE_STAT_CALL(ISE_CALL_SET_DUAL_POINT);
+  float values[4] = { refHigh, refLow, readHigh, readLow };
+
+  _write_registers(ISE_CALIBRATE_REFHIGH_REGISTER, values, 4);
+
+  // the firmware may flip the dual point bit on its own
+  _shadow_invalidate(ISE_CONFIG_REGISTER, 1);
+}
+
+void uFire_ISE::setCalibration(const ise_calibration_t &calibration)
+{
+  ISE_STAT_CALL(ISE_CALL_SET_CALIBRATION);
+  float values[5] = {
+    calibration.offset,
+    calibration.refHigh,
+    calibration.refLow,
+    calibration.readHigh,
+    calibration.readLow
+  };
+
+  _write_registers(ISE_CALIBRATE_SINGLE_REGISTER, values, 5);
+  _shadow_invalidate(ISE_CONFIG_REGISTER, 1);
+}
+
+ise_calibration_t uFire_ISE::getCalibration()
+{
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
+  ise_calibration_t calibration;
+  float values[5];
+
+  // the five registers are contiguous, so a cold shadow is filled with one
+  // block read rather than a pointer change per register
+  if (!_shadow_read(ISE_CALIBRATE_SINGLE_REGISTER, (uint8_t *)values, sizeof(values)))
+  {
+    _read_block(ISE_CALIBRATE_SINGLE_REGISTER, (uint8_t *)values, sizeof(values));
+    for (uint8_t i = 0; i < 5; i++)
+    {
+      _shadow_store(ISE_CALIBRATE_SINGLE_REGISTER + i * 4, (const uint8_t *)&values[i], 4);
+    }
+  }
+  calibration.offset   = values[0];
+  calibration.refHigh  = values[1];
+  calibration.refLow   = values[2];
+  calibration.readHigh = values[3];
+  calibration.readLow  = values[4];
+  return calibration;
 }
 
 float uFire_ISE::getCalibrateOffset()
 {
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
   return _read_register(ISE_CALIBRATE_SINGLE_REGISTER);
 }
 
 float uFire_ISE::getCalibrateHighReference()
 {
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
   return _read_register(ISE_CALIBRATE_REFHIGH_REGISTER);
 }
 
 float uFire_ISE::getCalibrateHighReading()
 {
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
   return _read_register(ISE_CALIBRATE_READHIGH_REGISTER);
 }
 
 float uFire_ISE::getCalibrateLowReference()
 {
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
   return _read_register(ISE_CALIBRATE_REFLOW_REGISTER);
 }
 
 float uFire_ISE::getCalibrateLowReading()
 {
+  ISE_STAT_CALL(ISE_CALL_GET_CALIBRATION);
   return _read_register(ISE_CALIBRATE_READLOW_REGISTER);
 }
 
+ise_snapshot_t uFire_ISE::saveCalibration()
+{
+  ise_snapshot_t snapshot;
+
+  _shadow_refresh();
+  snapshot.calibration = getCalibration();
+  snapshot.config      = _read_byte(ISE_CONFIG_REGISTER);
+  snapshot.firmware    = getFirmware();
+  return snapshot;
+}
+
+bool uFire_ISE::loadCalibration(const ise_snapshot_t &snapshot)
+{
+  if (snapshot.firmware != getFirmware()) return false;
+
+  // calibration is one block write, config one byte write, and each is
+  // skipped entirely if the probe already matches
+  setCalibration(snapshot.calibration);
+  _write_byte(ISE_CONFIG_REGISTER, snapshot.config);
+
+  _shadow_refresh();
+  ise_calibration_t calibration = getCalibration();
+
+  return (memcmp(&calibration, &snapshot.calibration, sizeof(calibration)) == 0) &&
+         (_read_byte(ISE_CONFIG_REGISTER) == snapshot.config);
+}
+
+size_t uFire_ISE::serializeCalibration(const ise_snapshot_t &snapshot, uint8_t *buf, size_t len)
+{
+  if (len < ISE_SNAPSHOT_SIZE) return 0;
+
+  // floats are stored in the byte order the probe uses on the bus
+  buf[0] = ISE_SNAPSHOT_FORMAT;
+  buf[1] = snapshot.firmware;
+  buf[2] = snapshot.config;
+  memcpy(&buf[3],  &snapshot.calibration.offset,   4);
+  memcpy(&buf[7],  &snapshot.calibration.refHigh,  4);
+  memcpy(&buf[11], &snapshot.calibration.refLow,   4);
+  memcpy(&buf[15], &snapshot.calibration.readHigh, 4);
+  memcpy(&buf[19], &snapshot.calibration.readLow,  4);
+  buf[23] = _crc8(buf, 23);
+  return ISE_SNAPSHOT_SIZE;
+}
+
+bool uFire_ISE::deserializeCalibration(const uint8_t *buf, size_t len, ise_snapshot_t &snapshot)
+{
+  if (len < ISE_SNAPSHOT_SIZE) return false;
+
+  if (buf[0] != ISE_SNAPSHOT_FORMAT) return false;
+
+  if (_crc8(buf, 23) != buf[23]) return false;
+
+  snapshot.firmware = buf[1];
+  snapshot.config   = buf[2];
+  memcpy(&snapshot.calibration.offset,   &buf[3],  4);
+  memcpy(&snapshot.calibration.refHigh,  &buf[7],  4);
+  memcpy(&snapshot.calibration.refLow,   &buf[11], 4);
+  memcpy(&snapshot.calibration.readHigh, &buf[15], 4);
+  memcpy(&snapshot.calibration.readLow,  &buf[19], 4);
+  return true;
+}
+
 void uFire_ISE::useTemperatureCompensation(bool b)
 {
+  ISE_STAT_CALL(ISE_CALL_TEMP_COMPENSATION);
   uint8_t retval;
   uint8_t config = _read_byte(ISE_CONFIG_REGISTER);
 
@@ -140,26 +410,28 @@ void uFire_ISE::useTemperatureCompensation(bool b)
 
 uint8_t uFire_ISE::getVersion()
 {
-  return _read_byte(ISE_VERSION_REGISTER);
+  // the hardware version never changes, so one successful read is enough
+  if (_version == 0xFF) _version = _read_byte(ISE_VERSION_REGISTER);
+
+  return _version;
 }
 
 uint8_t uFire_ISE::getFirmware()
 {
+  // like getVersion(), a 0xFF read is not kept, so the next call asks again
   return _read_byte(ISE_FW_VERSION_REGISTER);
 }
 
 void uFire_ISE::reset()
 {
-  _write_register(ISE_CALIBRATE_SINGLE_REGISTER, NAN);
-  delay(10);
-  _write_register(ISE_CALIBRATE_REFHIGH_REGISTER, NAN);
-  delay(10);
-  _write_register(ISE_CALIBRATE_REFLOW_REGISTER, NAN);
-  delay(10);
-  _write_register(ISE_CALIBRATE_READHIGH_REGISTER, NAN);
-  delay(10);
-  _write_register(ISE_CALIBRATE_READLOW_REGISTER, NAN);
-  delay(10);
+  ISE_STAT_CALL(ISE_CALL_RESET);
+  float values[5] = { NAN, NAN, NAN, NAN, NAN };
+
+  // always write, even if the shadow already holds NAN
+  _shadow_invalidate(ISE_CALIBRATE_SINGLE_REGISTER,
+                     ISE_SOLUTION_REGISTER - ISE_CALIBRATE_SINGLE_REGISTER);
+  _write_registers(ISE_CALIBRATE_SINGLE_REGISTER, values, 5);
+  _shadow_invalidate(ISE_CONFIG_REGISTER, 1);
   useTemperatureCompensation(false);
 }
 
@@ -172,6 +444,7 @@ void uFire_ISE::setI2CAddress(uint8_t i2cAddress)
 
 float uFire_ISE::readEEPROM(uint8_t address)
 {
+  ISE_STAT_CALL(ISE_CALL_READ_EEPROM);
   _write_register(ISE_SOLUTION_REGISTER, address);
   _send_command(ISE_MEMORY_READ);
   return _read_register(ISE_BUFFER_REGISTER);
@@ -179,6 +452,7 @@ float uFire_ISE::readEEPROM(uint8_t address)
 
 void uFire_ISE::writeEEPROM(uint8_t address, float value)
 {
+  ISE_STAT_CALL(ISE_CALL_WRITE_EEPROM);
   _write_register(ISE_SOLUTION_REGISTER, address);
   _write_register(ISE_BUFFER_REGISTER,   value);
   _send_command(ISE_MEMORY_WRITE);
@@ -188,10 +462,13 @@ bool uFire_ISE::connected()
 {
   uint8_t retval = _read_byte(ISE_VERSION_REGISTER);
 
+  _version = retval;
   if (retval != 0xFF) {
     return true;
   }
   else {
+    // the probe may come back reset, so nothing mirrored can be trusted
+    clearCache();
     return false;
   }
 }
@@ -207,18 +484,326 @@ bool uFire_ISE::getBlocking()
 }
 
 void uFire_ISE::readData()
+{
+  ISE_STAT_CALL(ISE_CALL_READ_DATA);
+  _updateRegisters();
+
+  // refresh every mirrored register in one block read so the getCalibrate*()
+  // calls that usually follow are served from the shadow
+  _shadow_refresh();
+}
+
+void uFire_ISE::clearCache()
+{
+  _version      = 0xFF;
+  _shadow_valid = 0;
+  _shadow_dirty = 0;
+}
+
+void uFire_ISE::useCacheStorage(ise_cache_load_t load, ise_cache_store_t store)
+{
+  _cache_load  = load;
+  _cache_store = store;
+}
+
+bool uFire_ISE::warmStart()
+{
+  uint8_t record[ISE_CACHE_SIZE];
+  uint8_t live[2];
+
+  if (!_cache_load || !_cache_load(_address, record, sizeof(record))) return false;
+
+  if ((record[0] != ISE_CACHE_FORMAT) || (record[1] != _address)) return false;
+
+  if (_crc8(record, ISE_CACHE_SIZE - 1) != record[ISE_CACHE_SIZE - 1]) return false;
+
+  // firmware and config sit next to each other, so one block read checks both
+  // against the record before it is trusted
+  _read_block(ISE_FW_VERSION_REGISTER, live, 2);
+  if ((live[0] != record[3]) || (live[1] != record[ISE_CACHE_SIZE - 2])) return false;
+
+  // the SOLUTION and BUFFER scratch registers are not part of the record;
+  // a power cycled probe does not keep them
+  memcpy(&_shadow[ISE_CALIBRATE_SINGLE_REGISTER - ISE_SHADOW_START], &record[4], ISE_CACHE_CALIBRATION_SIZE);
+  memcpy(&_shadow[ISE_FW_VERSION_REGISTER - ISE_SHADOW_START], live, 2);
+  _shadow_valid = _shadow_mask(ISE_CALIBRATE_SINGLE_REGISTER, ISE_CACHE_CALIBRATION_SIZE) |
+                  _shadow_mask(ISE_FW_VERSION_REGISTER, 2);
+  _shadow_dirty = 0;
+  _version      = record[2];
+  return true;
+}
+
+bool uFire_ISE::persistCache()
+{
+  uint8_t record[ISE_CACHE_SIZE];
+
+  if (!_cache_store) return false;
+
+  if (_shadow_valid != _shadow_mask(ISE_SHADOW_START, ISE_SHADOW_SIZE)) _shadow_refresh();
+  if (_shadow_valid != _shadow_mask(ISE_SHADOW_START, ISE_SHADOW_SIZE)) return false;
+
+  record[0] = ISE_CACHE_FORMAT;
+  record[1] = _address;
+  record[2] = getVersion();
+  record[3] = _shadow[ISE_FW_VERSION_REGISTER - ISE_SHADOW_START];
+  memcpy(&record[4], &_shadow[ISE_CALIBRATE_SINGLE_REGISTER - ISE_SHADOW_START], ISE_CACHE_CALIBRATION_SIZE);
+  record[ISE_CACHE_SIZE - 2] = _shadow[ISE_CONFIG_REGISTER - ISE_SHADOW_START];
+  record[ISE_CACHE_SIZE - 1] = _crc8(record, ISE_CACHE_SIZE - 1);
+  return _cache_store(_address, record, sizeof(record));
+}
+
+void uFire_ISE::setTiming(const ise_timing_t &timing)
+{
+  _timing = timing;
+}
+
+ise_timing_t uFire_ISE::getTiming()
+{
+  return _timing;
+}
+
+void uFire_ISE::useFirmwareTiming()
+{
+  uint8_t firmware = getFirmware();
+
+  // keep the current timing until the probe answers; no released firmware
+  // is known to tolerate a shorter gap, so ISE_TIMING_FAST is only ever
+  // chosen by the caller through setTiming()
+  if (firmware == 0xFF) return;
+
+  _timing = ISE_TIMING_STANDARD;
+}
+
+void uFire_ISE::setFilter(ise_filter_t filter, uint8_t samples, uint8_t window, float alpha)
+{
+  _filter         = filter;
+  _filter_samples = samples ? samples : 1;
+  _filter_window  = (window && window <= ISE_FILTER_SIZE) ? window : ISE_FILTER_SIZE;
+  _filter_alpha   = alpha;
+  _history.head   = 0;
+  _history.count  = 0;
+}
+
+void uFire_ISE::useTaskPolling(bool b)
+{
+  _task_polling = b;
+}
+
+bool uFire_ISE::usingTaskPolling()
+{
+  return _task_polling;
+}
+
+void uFire_ISE::useBurstReads(bool b)
+{
+  _burst_reads = b;
+}
+
+bool uFire_ISE::usingBurstReads()
+{
+  return _burst_reads;
+}
+
+#if defined(ISE_STATS)
+ise_stats_t uFire_ISE::getStats()
+{
+  return _stats;
+}
+
+void uFire_ISE::resetStats()
+{
+  _stats = ise_stats_t();
+}
+#endif // if defined(ISE_STATS)
+
+void uFire_ISE::startMeasuremV()
+{
+  _start(ISE_MEASURE_MV, _timing.mv_time);
+}
+
+void uFire_ISE::startMeasureTemp()
+{
+  _start(ISE_MEASURE_TEMP, _timing.temp_time);
+}
+
+bool uFire_ISE::update()
+{
+  ISE_STAT_CALL(ISE_CALL_UPDATE);
+  bool mv = _pending == ISE_MEASURE_MV;
+
+  if (!_poll()) return false;
+
+  if (mv) _measured();
+  _complete();
+  return true;
+}
+
+bool uFire_ISE::busy()
+{
+  return _pending != 0;
+}
+
+void uFire_ISE::onComplete(uFire_ISE_callback callback)
+{
+  _callback = callback;
+}
+
+void uFire_ISE::startContinuous(uFire_ISE_SampleBuffer *buffer)
+{
+  _buffer = buffer;
+  if (!_pending) startMeasuremV();
+}
+
+void uFire_ISE::stopContinuous()
+{
+  _buffer = nullptr;
+}
+
+void uFire_ISE::_start(uint8_t command, unsigned long duration, bool settle)
+{
+  _send_command(command, settle);
+  _pending       = command;
+  _started       = millis();
+  _polled        = _started;
+  _poll_interval = ISE_TASK_POLL_MIN;
+  _poll_armed    = false;
+  _duration      = duration;
+}
+
+bool uFire_ISE::_poll()
+{
+  if (!_pending) return false;
+
+  unsigned long now = millis();
+  unsigned long gap = (_timing.gap_us + 999) / 1000;
+
+  if (now - _started < _duration)
+  {
+    if (!_task_polling) return false;
+
+    // a poll is split over two calls, pointer then read, so update() never
+    // sits out the gap between them; the interval doubles while the
+    // firmware is still busy
+    if (!_poll_armed)
+    {
+      if (now - _polled < (_poll_interval > gap ? _poll_interval : gap)) return false;
+      Wire.beginTransmission(_address);
+      Wire.write(ISE_TASK_REGISTER);
+      _end_transmission(1);
+      _poll_armed = true;
+      _polled     = now;
+      return false;
+    }
+    if (now - _polled < gap) return false;
+
+    _request(1);
+    uint8_t task = Wire.read();
+
+    _poll_armed = false;
+    _polled     = now;
+    if (task)
+    {
+      if (_poll_interval < ISE_TASK_POLL_MAX) _poll_interval *= 2;
+      return false;
+    }
+
+    // done early, read on a later call once the gap has passed
+    _duration = now - _started;
+  }
+  if (now - _polled < gap) return false;
+
+  _updateRegisters();
+  if ((_pending == ISE_MEASURE_MV) && (_filter != ISE_FILTER_NONE) && (mV != -1))
+  {
+    _filter_push(_history, mV);
+    mV = _filter_value(_history, _filter, _filter_window);
+  }
+  return true;
+}
+
+void uFire_ISE::_complete()
+{
+  bool mv = _pending == ISE_MEASURE_MV;
+
+  _pending = 0;
+  if (mv && _buffer)
+  {
+    ise_sample_t sample;
+
+    sample.timestamp_us = micros();
+    sample.mV           = mV;
+    sample.tempC        = tempC;
+    sample.derived      = _derived;
+    _buffer->push(sample);
+  }
+  if (_callback) _callback(this);
+
+  // continuous mode keeps a conversion in flight at all times
+  if (mv && _buffer && !_pending) startMeasuremV();
+}
+
+void uFire_ISE::_filter_push(ise_filter_history_t &history, float sample)
+{
+  history.ema = history.count ? history.ema + _filter_alpha * (sample - history.ema) : sample;
+
+  history.ring[history.head] = sample;
+  history.head               = (history.head + 1) % ISE_FILTER_SIZE;
+  if (history.count < ISE_FILTER_SIZE) history.count++;
+}
+
+float uFire_ISE::_filter_value(const ise_filter_history_t &history, ise_filter_t filter, uint8_t size)
+{
+  float   window[ISE_FILTER_SIZE];
+  uint8_t n = history.count < size ? history.count : size;
+
+  if (!n) return mV;
+
+  if (filter == ISE_FILTER_EMA) return history.ema;
+
+  // newest n samples, sorted for the order statistics
+  for (uint8_t i = 0; i < n; i++)
+  {
+    float   x = history.ring[(history.head + ISE_FILTER_SIZE - 1 - i) % ISE_FILTER_SIZE];
+    uint8_t j = i;
+
+    if (filter == ISE_FILTER_MEAN)
+    {
+      window[i] = x;
+      continue;
+    }
+    while (j && (window[j - 1] > x))
+    {
+      window[j] = window[j - 1];
+      j--;
+    }
+    window[j] = x;
+  }
+
+  if (filter == ISE_FILTER_MEDIAN)
+  {
+    return (n & 1) ? window[n / 2] : (window[n / 2 - 1] + window[n / 2]) / 2;
+  }
+
+  uint8_t trim = (filter == ISE_FILTER_TRIMMED_MEAN) ? n / 4 : 0;
+  float   sum  = 0;
+
+  for (uint8_t i = trim; i < n - trim; i++) sum += window[i];
+  return sum / (n - 2 * trim);
+}
+
+void uFire_ISE::readMeasurements()
 {
   _updateRegisters();
-  getCalibrateHighReading();
-  getCalibrateHighReference();
-  getCalibrateLowReading();
-  getCalibrateLowReference();
-  getCalibrateOffset();
 }
 
 void uFire_ISE::_updateRegisters()
 {
-  mV = _read_register(ISE_MV_REGISTER);
+  // mV and temperature are adjacent, so fetch both in one 8-byte block read
+  float data[2];
+
+  _read_block(ISE_MV_REGISTER, (uint8_t *)data, sizeof(data));
+
+  mV = data[0];
   if (isinf(mV)) {
     mV = -1;
   }
@@ -226,7 +811,7 @@ void uFire_ISE::_updateRegisters()
     mV = -1;
   }
 
-  tempC = _read_register(ISE_TEMP_REGISTER);
+  tempC = data[1];
   if (tempC == -127.0)
   {
     tempF = -127;
@@ -238,21 +823,234 @@ void uFire_ISE::_updateRegisters()
 
 }
 
+bool uFire_ISE::_shadowed(uint8_t reg, uint8_t len)
+{
+  return (reg >= ISE_SHADOW_START) && (reg + len <= ISE_SHADOW_END);
+}
+
+uint32_t uFire_ISE::_shadow_mask(uint8_t reg, uint8_t len)
+{
+  uint32_t mask = (len >= 32) ? 0xFFFFFFFF : ((1UL << len) - 1);
+
+  return mask << (reg - ISE_SHADOW_START);
+}
+
+bool uFire_ISE::_shadow_read(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+  uint32_t mask = _shadow_mask(reg, len);
+
+  if ((_shadow_valid & mask) != mask) return false;
+
+  memcpy(buf, &_shadow[reg - ISE_SHADOW_START], len);
+  return true;
+}
+
+bool uFire_ISE::_blank(const uint8_t *buf, uint8_t len)
+{
+  // a disconnected probe reads as all 0xFF
+  while (len--)
+  {
+    if (*buf++ != 0xFF) return false;
+  }
+  return true;
+}
+
+void uFire_ISE::_shadow_store(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+  uint32_t mask = _shadow_mask(reg, len);
+
+  if (_blank(buf, len)) return;
+
+  memcpy(&_shadow[reg - ISE_SHADOW_START], buf, len);
+  _shadow_valid |= mask;
+  _shadow_dirty &= ~mask;
+}
+
+void uFire_ISE::_shadow_write(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+  uint32_t mask    = _shadow_mask(reg, len);
+  bool     scratch = (reg < ISE_FW_VERSION_REGISTER) && (reg + len > ISE_SOLUTION_REGISTER);
+
+  // a register is written whole or not at all, so the device never latches
+  // half of a float; SOLUTION and BUFFER are command parameters that do not
+  // survive a probe reset and always go out
+  if (!scratch && ((_shadow_valid & mask) == mask) &&
+      !memcmp(&_shadow[reg - ISE_SHADOW_START], buf, len)) return;
+
+  memcpy(&_shadow[reg - ISE_SHADOW_START], buf, len);
+  _shadow_valid |= mask;
+  _shadow_dirty |= mask;
+}
+
+void uFire_ISE::_shadow_invalidate(uint8_t reg, uint8_t len)
+{
+  uint32_t mask = _shadow_mask(reg, len);
+
+  _shadow_valid &= ~mask;
+  _shadow_dirty &= ~mask;
+}
+
+void uFire_ISE::_shadow_refresh()
+{
+  _read_block(ISE_SHADOW_START, _shadow, ISE_SHADOW_SIZE);
+  _shadow_valid = _blank(_shadow, ISE_SHADOW_SIZE) ? 0 : _shadow_mask(ISE_SHADOW_START, ISE_SHADOW_SIZE);
+  _shadow_dirty = 0;
+}
+
+uint8_t uFire_ISE::_crc8(const uint8_t *buf, size_t len)
+{
+  // CRC-8, polynomial 0x07
+  uint8_t crc = 0;
+
+  while (len--)
+  {
+    crc ^= *buf++;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+void uFire_ISE::_shadow_flush()
+{
+  uint8_t i = 0;
+
+  // write each run of dirty registers as one transaction, bridging over
+  // clean registers whose value is known
+  while (i < ISE_SHADOW_SIZE)
+  {
+    if (!(_shadow_dirty & (1UL << i)))
+    {
+      i++;
+      continue;
+    }
+
+    uint8_t start = i;
+    uint8_t last  = i;
+
+    while ((i < ISE_SHADOW_SIZE) && (_shadow_valid & (1UL << i)))
+    {
+      if (_shadow_dirty & (1UL << i)) last = i;
+      i++;
+    }
+    _write_block(ISE_SHADOW_START + start, &_shadow[start], last - start + 1);
+  }
+  _shadow_dirty = 0;
+}
+
+void uFire_ISE::_gap()
+{
+  // delayMicroseconds() is only accurate for short waits
+  if (_timing.gap_us >= 1000) delay(_timing.gap_us / 1000);
+  if (_timing.gap_us % 1000) delayMicroseconds(_timing.gap_us % 1000);
+#if defined(ISE_STATS)
+  _stats.delay_us += _timing.gap_us;
+#endif // if defined(ISE_STATS)
+}
+
+void uFire_ISE::_delay(unsigned long ms)
+{
+  delay(ms);
+#if defined(ISE_STATS)
+  _stats.delay_us += (uint64_t)ms * 1000;
+#endif // if defined(ISE_STATS)
+}
+
+void uFire_ISE::_end_transmission(uint8_t written)
+{
+  uint8_t error = Wire.endTransmission();
+
+  // any other transaction moves the register pointer off a pending poll
+  _poll_armed = false;
+
+#if defined(ISE_STATS)
+  _stats.transactions++;
+  _stats.bytes_written += written;
+  if (error) _stats.nacks++;
+#else // if defined(ISE_STATS)
+  (void)written;
+  (void)error;
+#endif // if defined(ISE_STATS)
+}
+
+void uFire_ISE::_request(uint8_t len)
+{
+  uint8_t received = Wire.requestFrom(_address, len);
+
+#if defined(ISE_STATS)
+  _stats.transactions++;
+  _stats.bytes_read += received;
+#else // if defined(ISE_STATS)
+  (void)received;
+#endif // if defined(ISE_STATS)
+}
+
+void uFire_ISE::_wait(unsigned long timeout)
+{
+  if (!_task_polling)
+  {
+    _delay(timeout);
+    return;
+  }
+
+  // the firmware clears the task register when it is done, so poll it with
+  // a growing interval and treat timeout as the upper bound
+  unsigned long start    = millis();
+  unsigned long interval = ISE_TASK_POLL_MIN;
+
+  while (millis() - start < timeout)
+  {
+    unsigned long remaining = timeout - (millis() - start);
+
+    _delay(interval < remaining ? interval : remaining);
+    if (_task_done()) return;
+    if (interval < ISE_TASK_POLL_MAX) interval *= 2;
+  }
+}
+
+bool uFire_ISE::_task_done()
+{
+  return _read_byte(ISE_TASK_REGISTER) == 0;
+}
+
 void uFire_ISE::_change_register(uint8_t r)
 {
   Wire.beginTransmission(_address);
   Wire.write(r);
-  Wire.endTransmission();
-  delay(10);
+  _end_transmission(1);
+  _gap();
 }
 
-void uFire_ISE::_send_command(uint8_t command)
+void uFire_ISE::_send_command(uint8_t command, bool settle)
 {
   Wire.beginTransmission(_address);
   Wire.write(ISE_TASK_REGISTER);
   Wire.write(command);
-  Wire.endTransmission();
-  delay(10);
+  _end_transmission(2);
+  if (command == ISE_MEMORY_WRITE) _delay(_timing.eeprom_time);
+  else if (settle) _gap();
+
+  // drop whatever the firmware rewrites while handling the command
+  switch (command)
+  {
+  case ISE_CALIBRATE_SINGLE:
+  case ISE_CALIBRATE_LOW:
+  case ISE_CALIBRATE_HIGH:
+    _shadow_invalidate(ISE_CALIBRATE_SINGLE_REGISTER,
+                       ISE_SOLUTION_REGISTER - ISE_CALIBRATE_SINGLE_REGISTER);
+    _shadow_invalidate(ISE_CONFIG_REGISTER, 1);
+    break;
+
+  case ISE_MEMORY_READ:
+    _shadow_invalidate(ISE_BUFFER_REGISTER, 4);
+    break;
+
+  case ISE_I2C:
+    clearCache();
+    break;
+  }
 }
 
 void uFire_ISE::_write_register(uint8_t reg, float f)
@@ -260,6 +1058,13 @@ void uFire_ISE::_write_register(uint8_t reg, float f)
   uint8_t b[5];
   float   f_val = f;
 
+  if (_shadowed(reg, 4))
+  {
+    _shadow_write(reg, (uint8_t *)&f_val, 4);
+    _shadow_flush();
+    return;
+  }
+
   b[0] = reg;
   b[1] = *((uint8_t *)&f_val);
   b[2] = *((uint8_t *)&f_val + 1);
@@ -267,47 +1072,119 @@ void uFire_ISE::_write_register(uint8_t reg, float f)
   b[4] = *((uint8_t *)&f_val + 3);
   Wire.beginTransmission(_address);
   Wire.write(b, 5);
-  Wire.endTransmission();
-  delay(10);
+  _end_transmission(5);
+  _gap();
+}
+
+void uFire_ISE::_write_registers(uint8_t reg, const float *values, uint8_t count)
+{
+  // stage every value, then send the changed run in one transaction
+  if (_shadowed(reg, count * 4))
+  {
+    for (uint8_t i = 0; i < count; i++)
+    {
+      _shadow_write(reg + i * 4, (const uint8_t *)&values[i], 4);
+    }
+    _shadow_flush();
+    return;
+  }
+
+  _write_block(reg, (const uint8_t *)values, count * 4);
 }
 
 float uFire_ISE::_read_register(uint8_t reg)
 {
   float retval;
 
-  _change_register(reg);
+  if (_shadowed(reg, 4))
+  {
+    if (!_shadow_read(reg, (uint8_t *)&retval, 4))
+    {
+      _read_block(reg, (uint8_t *)&retval, 4);
+      _shadow_store(reg, (uint8_t *)&retval, 4);
+    }
+    return retval;
+  }
 
-  Wire.requestFrom(_address, (uint8_t)1);
-  *((uint8_t *)&retval) = Wire.read();
-  Wire.requestFrom(_address, (uint8_t)1);
-  *((uint8_t *)&retval + 1) = Wire.read();
-  Wire.requestFrom(_address, (uint8_t)1);
-  *((uint8_t *)&retval + 2) = Wire.read();
-  Wire.requestFrom(_address, (uint8_t)1);
-  *((uint8_t *)&retval + 3) = Wire.read();
-  delay(10);
+  _read_block(reg, (uint8_t *)&retval, sizeof(retval));
   return retval;
 }
 
+void uFire_ISE::_read_block(uint8_t reg, uint8_t *buf, uint8_t len)
+{
+  _change_register(reg);
+
+  // the firmware advances the register pointer after each byte; by default
+  // every byte is its own request as the Python and Rust drivers do, and
+  // with useBurstReads() a run is fetched in as few requests as the Wire
+  // buffer allows
+  uint8_t size = _burst_reads ? ISE_I2C_BUFFER_LENGTH : 1;
+
+  while (len)
+  {
+    uint8_t n = len > size ? size : len;
+
+    _request(n);
+    for (uint8_t i = 0; i < n; i++)
+    {
+      *buf++ = Wire.read();
+    }
+    len -= n;
+  }
+  _gap();
+}
+
+void uFire_ISE::_write_block(uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+  // one byte of each transmission is taken by the register address
+  while (len)
+  {
+    uint8_t n = len > ISE_I2C_BUFFER_LENGTH - 1 ? ISE_I2C_BUFFER_LENGTH - 1 : len;
+
+    Wire.beginTransmission(_address);
+    Wire.write(reg);
+    Wire.write(buf, n);
+    _end_transmission(n + 1);
+    reg += n;
+    buf += n;
+    len -= n;
+  }
+  _gap();
+}
+
 void uFire_ISE::_write_byte(uint8_t reg, uint8_t val)
 {
   uint8_t b[5];
 
+  if (_shadowed(reg, 1))
+  {
+    _shadow_write(reg, &val, 1);
+    _shadow_flush();
+    return;
+  }
+
   b[0] = reg;
   b[1] = val;
   Wire.beginTransmission(_address);
   Wire.write(b, 2);
-  Wire.endTransmission();
-  delay(10);
+  _end_transmission(2);
+  _gap();
 }
 
 uint8_t uFire_ISE::_read_byte(uint8_t reg)
 {
   uint8_t retval;
 
+  if (_shadowed(reg, 1) && _shadow_read(reg, &retval, 1))
+  {
+    return retval;
+  }
+
   _change_register(reg);
-  Wire.requestFrom(_address, (uint8_t)1);
+  _request(1);
   retval = Wire.read();
-  delay(10);
+  _gap();
+
+  if (_shadowed(reg, 1)) _shadow_store(reg, &retval, 1);
   return retval;
 }
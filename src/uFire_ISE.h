@@ -26,6 +26,7 @@
 #define ISEPROBE_H
 
 #include <math.h>
+#include "uFire_ISE_SampleBuffer.h"
 
 #if defined(PARTICLE)
 # include "application.h"
@@ -65,27 +66,204 @@
 #define ISE_TEMP_MEASURE_TIME 750
 #define ISE_MV_MEASURE_TIME 250
 
+#define ISE_TASK_POLL_MIN 5                /*!< first task register poll interval in ms */
+#define ISE_TASK_POLL_MAX 40               /*!< longest task register poll interval in ms */
+
+#ifndef ISE_I2C_BUFFER_LENGTH
+# define ISE_I2C_BUFFER_LENGTH 32          /*!< largest single requestFrom() the Wire buffer allows */
+#endif // ifndef ISE_I2C_BUFFER_LENGTH
+
+#define ISE_SHADOW_START ISE_CALIBRATE_SINGLE_REGISTER /*!< first register mirrored in the shadow */
+#define ISE_SHADOW_END (ISE_CONFIG_REGISTER + 1)      /*!< one past the last mirrored register */
+#define ISE_SHADOW_SIZE (ISE_SHADOW_END - ISE_SHADOW_START)
+
+#define ISE_STABLE_WINDOW 8                /*!< samples in the settling window */
+#define ISE_STABLE_SLOPE 0.05              /*!< default settled drift limit in mV/s */
+#define ISE_STABLE_NOISE 0.5               /*!< default settled standard deviation limit in mV */
+#define ISE_STABLE_TIMEOUT 120000          /*!< default give-up time in ms */
+
+#ifndef ISE_FILTER_SIZE
+# define ISE_FILTER_SIZE 16                /*!< samples kept for filtering */
+#endif // ifndef ISE_FILTER_SIZE
+
 #define ISE_DUALPOINT_CONFIG_BIT 0         /*!< dual point config bit */
 #define ISE_TEMP_COMPENSATION_CONFIG_BIT 1 /*!< temperature compensation config bit */
 
+enum ise_filter_t                  /*! how measuremV() combines samples */
+{
+  ISE_FILTER_NONE,                 /*!< latest conversion only */
+  ISE_FILTER_MEAN,                 /*!< mean of the window */
+  ISE_FILTER_MEDIAN,               /*!< median of the window */
+  ISE_FILTER_TRIMMED_MEAN,         /*!< mean of the window without the lowest and highest quarter */
+  ISE_FILTER_EMA                   /*!< exponential moving average */
+};
+
+typedef struct ise_filter_history_t /*! samples a filter reduces over */
+{
+  float   ring[ISE_FILTER_SIZE];
+  uint8_t head;  /*!< next slot to write */
+  uint8_t count; /*!< samples held, up to ISE_FILTER_SIZE */
+  float   ema;   /*!< ISE_FILTER_EMA state */
+} ise_filter_history_t;
+
+typedef struct ise_timing_t         /*! bus and conversion timing */
+{
+  uint16_t gap_us;      /*!< wait after each bus transaction, in microseconds */
+  uint16_t mv_time;     /*!< mV conversion time in ms */
+  uint16_t temp_time;   /*!< temperature conversion time in ms */
+  uint16_t eeprom_time; /*!< wait after an EEPROM write command in ms */
+} ise_timing_t;
+
+const ise_timing_t ISE_TIMING_STANDARD = { 10000, ISE_MV_MEASURE_TIME, ISE_TEMP_MEASURE_TIME, 10 }; /*!< every released firmware */
+const ise_timing_t ISE_TIMING_FAST     = { 1000, ISE_MV_MEASURE_TIME, ISE_TEMP_MEASURE_TIME, 10 };  /*!< opt-in through setTiming(), not verified against any firmware */
+
+typedef struct ise_calibration_t   /*! calibration registers 9 to 28, in register order */
+{
+  float offset;   /*!< single point offset */
+  float refHigh;  /*!< dual point high reference */
+  float refLow;   /*!< dual point low reference */
+  float readHigh; /*!< dual point high reading */
+  float readLow;  /*!< dual point low reading */
+} ise_calibration_t;
+
+typedef struct ise_snapshot_t      /*! everything needed to clone a probe's calibration */
+{
+  ise_calibration_t calibration;
+  uint8_t           config;   /*!< ISE_CONFIG_REGISTER */
+  uint8_t           firmware; /*!< firmware the snapshot was taken from */
+} ise_snapshot_t;
+
+#define ISE_SNAPSHOT_FORMAT 1  /*!< first byte of a serialized snapshot */
+#define ISE_SNAPSHOT_SIZE 24   /*!< format, firmware, config, 5 floats, CRC-8 */
+
+#define ISE_CACHE_FORMAT 2                     /*!< first byte of a persisted register cache */
+#define ISE_CACHE_CALIBRATION_SIZE (ISE_SOLUTION_REGISTER - ISE_CALIBRATE_SINGLE_REGISTER) /*!< registers 9 to 28 */
+#define ISE_CACHE_SIZE (6 + ISE_CACHE_CALIBRATION_SIZE) /*!< format, address, version, firmware, calibration, config, CRC-8 */
+
+typedef bool (*ise_cache_load_t)(uint8_t  address,
+                                 uint8_t *buf,
+                                 size_t   len);        /*!< fills buf with a stored record */
+typedef bool (*ise_cache_store_t)(uint8_t        address,
+                                  const uint8_t *buf,
+                                  size_t         len); /*!< saves a record */
+
+#if defined(ISE_STATS)
+enum ise_call_t                    /*! public calls tracked in ise_stats_t */
+{
+  ISE_CALL_MEASURE_MV,
+  ISE_CALL_MEASURE_TEMP,
+  ISE_CALL_MEASURE_PH,
+  ISE_CALL_MEASURE_ORP,
+  ISE_CALL_CALIBRATE_SINGLE,
+  ISE_CALL_CALIBRATE_LOW,
+  ISE_CALL_CALIBRATE_HIGH,
+  ISE_CALL_SET_DUAL_POINT,
+  ISE_CALL_SET_CALIBRATION,
+  ISE_CALL_GET_CALIBRATION,
+  ISE_CALL_TEMP_COMPENSATION,
+  ISE_CALL_RESET,
+  ISE_CALL_READ_EEPROM,
+  ISE_CALL_WRITE_EEPROM,
+  ISE_CALL_READ_DATA,
+  ISE_CALL_UPDATE,
+  ISE_CALL_COUNT
+};
+
+typedef struct ise_call_stats_t
+{
+  uint32_t count;   /*!< times called */
+  uint64_t time_us; /*!< wall time spent inside, in microseconds */
+} ise_call_stats_t;
+
+typedef struct ise_stats_t         /*! bus cost counters, enabled with ISE_STATS */
+{
+  uint32_t         transactions;  /*!< endTransmission() and requestFrom() calls */
+  uint32_t         bytes_written; /*!< bytes sent, including register addresses */
+  uint32_t         bytes_read;    /*!< bytes received */
+  uint32_t         nacks;         /*!< transmissions endTransmission() reported as failed */
+  uint64_t         delay_us;      /*!< time spent in blocking waits, in microseconds */
+  ise_call_stats_t calls[ISE_CALL_COUNT];
+} ise_stats_t;
+
+class uFire_ISE_CallTimer          /*! adds the lifetime of a scope to a call counter */
+{
+public:
+
+  uFire_ISE_CallTimer(ise_call_stats_t &stats) : _stats(stats), _start(micros()) {}
+  ~uFire_ISE_CallTimer()
+  {
+    _stats.count++;
+    _stats.time_us += micros() - _start;
+  }
+
+private:
+
+  ise_call_stats_t &_stats;
+  unsigned long     _start;
+};
+
+# define ISE_STAT_CALL(call) uFire_ISE_CallTimer _ise_call_timer(_stats.calls[call])
+#else // if defined(ISE_STATS)
+# define ISE_STAT_CALL(call)
+#endif // if defined(ISE_STATS)
+
+class uFire_ISE;
+typedef void (*uFire_ISE_callback)(uFire_ISE *); /*!< called when a started measurement completes */
+
 class uFire_ISE                            /*! ISE Class */
 {
+  friend class uFire_ISEGroup;
+  friend class uFire_ISE_CommandBase;
+
 public:
 
   uint8_t _address;
   float tempC; /*!< Temperature in C */
   float tempF; /*!< Temperature in F */
   float mV;    /*!< mV of probe */
+  float uncertainty;   /*!< standard error of mV from measuremVAdaptive() */
+  uint8_t sampleCount; /*!< conversions measuremVAdaptive() used */
+  unsigned long settleTime; /*!< ms the last *WhenStable() call waited */
   bool  begin(uint8_t address=ISE_PROBE_I2C, TwoWire &wirePort=Wire);
   float measuremV();
+  float measuremV(uint8_t      samples,
+                  ise_filter_t filter);
+  float measuremVAdaptive(float   tolerance,
+                          uint8_t max_samples=ISE_FILTER_SIZE,
+                          uint8_t min_samples=3);
   float measureTemp();
   float  calibrateSingle(float solutionmV);
   float  calibrateProbeLow(float solutionmV);
   float  calibrateProbeHigh(float solutionmV);
+  float  calibrateSingleWhenStable(float         solutionmV,
+                                   unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                   float         slope=ISE_STABLE_SLOPE,
+                                   float         noise=ISE_STABLE_NOISE);
+  float  calibrateProbeLowWhenStable(float         solutionmV,
+                                     unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                     float         slope=ISE_STABLE_SLOPE,
+                                     float         noise=ISE_STABLE_NOISE);
+  float  calibrateProbeHighWhenStable(float         solutionmV,
+                                      unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                      float         slope=ISE_STABLE_SLOPE,
+                                      float         noise=ISE_STABLE_NOISE);
+  bool   waitStable(unsigned long timeout=ISE_STABLE_TIMEOUT,
+                    float         slope=ISE_STABLE_SLOPE,
+                    float         noise=ISE_STABLE_NOISE);
   void  setDualPointCalibration(float refLow,
                                 float refHigh,
                                 float readLow,
                                 float readHigh);
+  void    setCalibration(const ise_calibration_t &calibration);
+  ise_calibration_t getCalibration();
+  ise_snapshot_t saveCalibration();
+  bool    loadCalibration(const ise_snapshot_t &snapshot);
+  static size_t serializeCalibration(const ise_snapshot_t &snapshot,
+                                     uint8_t              *buf,
+                                     size_t                len);
+  static bool   deserializeCalibration(const uint8_t  *buf,
+                                       size_t          len,
+                                       ise_snapshot_t &snapshot);
   float   getCalibrateOffset();
   void    useTemperatureCompensation(bool b);
   void    setTemp(float temp_C);
@@ -104,19 +282,128 @@ public:
   void    setBlocking(bool);
   bool    getBlocking();
   void    readData();
+  void    readMeasurements();
+  void    startMeasuremV();
+  void    startMeasureTemp();
+  bool    update();
+  bool    busy();
+  void    onComplete(uFire_ISE_callback callback);
+  void    startContinuous(uFire_ISE_SampleBuffer *buffer);
+  void    stopContinuous();
+  void    clearCache();
+  void    useCacheStorage(ise_cache_load_t  load,
+                          ise_cache_store_t store);
+  bool    warmStart();
+  bool    persistCache();
+  void    setTiming(const ise_timing_t &timing);
+  ise_timing_t getTiming();
+  void    useFirmwareTiming();
+  void    setFilter(ise_filter_t filter,
+                    uint8_t      samples=1,
+                    uint8_t      window=ISE_FILTER_SIZE,
+                    float        alpha=0.25);
+  void    useTaskPolling(bool b);
+  bool    usingTaskPolling();
+  void    useBurstReads(bool b);
+  bool    usingBurstReads();
+#if defined(ISE_STATS)
+  ise_stats_t getStats();
+  void    resetStats();
+#endif // if defined(ISE_STATS)
+
+protected:
+
+  uint8_t _pending = 0;
+  float   _derived = NAN;
+  ise_timing_t _timing = ISE_TIMING_STANDARD;
+  bool    _poll();
+  void    _complete();
+  virtual void _measured() {} /*!< derives pH, Eh etc. once update() has read an mV conversion */
+#if defined(ISE_STATS)
+  ise_stats_t _stats = {};
+#endif // if defined(ISE_STATS)
 
 private:
 
   TwoWire *_i2cPort;
   bool    _blocking = true;
+  unsigned long _started;
+  unsigned long _duration;
+  unsigned long _polled;
+  uint8_t _poll_interval;
+  bool    _poll_armed = false;
+  bool    _task_polling = false;
+  bool    _burst_reads = false;
+  uFire_ISE_callback _callback = nullptr;
+  uFire_ISE_SampleBuffer *_buffer = nullptr;
+  uint8_t  _shadow[ISE_SHADOW_SIZE];
+  uint32_t _shadow_valid = 0;
+  uint32_t _shadow_dirty = 0;
+  uint8_t  _version = 0xFF;
+  ise_filter_t _filter = ISE_FILTER_NONE;
+  uint8_t  _filter_samples = 1;
+  uint8_t  _filter_window  = ISE_FILTER_SIZE;
+  float    _filter_alpha   = 0.25;
+  ise_filter_history_t _history = {};
+  void     _filter_push(ise_filter_history_t &history,
+                        float                 sample);
+  float    _filter_value(const ise_filter_history_t &history,
+                         ise_filter_t                filter,
+                         uint8_t                     size);
+  float    _measuremV(uint8_t               samples,
+                      ise_filter_t          filter,
+                      uint8_t               window,
+                      ise_filter_history_t &history);
+  ise_cache_load_t  _cache_load  = nullptr;
+  ise_cache_store_t _cache_store = nullptr;
+  bool    _shadowed(uint8_t reg,
+                    uint8_t len);
+  uint32_t _shadow_mask(uint8_t reg,
+                        uint8_t len);
+  bool    _shadow_read(uint8_t  reg,
+                       uint8_t *buf,
+                       uint8_t  len);
+  void    _shadow_store(uint8_t        reg,
+                        const uint8_t *buf,
+                        uint8_t        len);
+  void    _shadow_write(uint8_t        reg,
+                        const uint8_t *buf,
+                        uint8_t        len);
+  void    _shadow_invalidate(uint8_t reg,
+                             uint8_t len);
+  void    _shadow_flush();
+  void    _shadow_refresh();
+  static bool _blank(const uint8_t *buf,
+                     uint8_t        len);
+  static uint8_t _crc8(const uint8_t *buf,
+                       size_t         len);
+  void    _start(uint8_t       command,
+                 unsigned long duration,
+                 bool          settle=true);
   void    _updateRegisters();
+  void    _gap();
+  void    _delay(unsigned long ms);
+  void    _end_transmission(uint8_t written);
+  void    _request(uint8_t len);
+  void    _wait(unsigned long timeout);
+  bool    _task_done();
   void    _change_register(uint8_t register);
-  void    _send_command(uint8_t command);
+  void    _send_command(uint8_t command,
+                        bool    settle=true);
   void    _write_register(uint8_t reg,
                           float   f);
+  void    _write_registers(uint8_t      reg,
+                           const float *values,
+                           uint8_t      count);
   void    _write_byte(uint8_t reg,
                       uint8_t val);
   float   _read_register(uint8_t reg);
+  void    _read_block(uint8_t  reg,
+                      uint8_t *buf,
+                      uint8_t  len);
+  void    _write_block(uint8_t        reg,
+                       const uint8_t *buf,
+                       uint8_t        len);
   uint8_t _read_byte(uint8_t reg);
 };
 
@@ -0,0 +1,134 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISEGroup.h"
+
+bool uFire_ISEGroup::add(uFire_ISE *ise)
+{
+  if (_count >= ISE_GROUP_MAX) return false;
+
+  _members[_count++] = ise;
+  return true;
+}
+
+uint8_t uFire_ISEGroup::size()
+{
+  return _count;
+}
+
+uFire_ISE * uFire_ISEGroup::get(uint8_t index)
+{
+  if (index >= _count) return nullptr;
+
+  return _members[index];
+}
+
+void uFire_ISEGroup::measuremV()
+{
+  uint8_t rounds = 1;
+
+  // a member set up with setFilter(filter, samples) gets as many
+  // conversions as its own measuremV() would take, each round shared with
+  // the members that still need one
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_members[i]->_filter_samples > rounds) rounds = _members[i]->_filter_samples;
+  }
+  for (uint8_t round = 0; round < rounds; round++)
+  {
+    _trigger(ISE_MEASURE_MV, round);
+    _collect();
+  }
+}
+
+void uFire_ISEGroup::measureTemp()
+{
+  startMeasureTemp();
+  _collect();
+}
+
+void uFire_ISEGroup::startMeasuremV()
+{
+  _trigger(ISE_MEASURE_MV, 0);
+}
+
+void uFire_ISEGroup::startMeasureTemp()
+{
+  _trigger(ISE_MEASURE_TEMP, 0);
+}
+
+bool uFire_ISEGroup::update()
+{
+  bool pending = false;
+
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_members[i]->busy() && !_members[i]->update()) pending = true;
+  }
+  return !pending;
+}
+
+bool uFire_ISEGroup::busy()
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (_members[i]->busy()) return true;
+  }
+  return false;
+}
+
+void uFire_ISEGroup::_trigger(uint8_t command, uint8_t round)
+{
+  uFire_ISE *last = nullptr;
+
+  // commands go out back-to-back without the usual settle time so every
+  // probe starts converting within a few bus transactions of the others
+  if (!round) timestamp = millis();
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    uFire_ISE *ise = _members[i];
+    unsigned long duration = command == ISE_MEASURE_MV ? ise->_timing.mv_time : ise->_timing.temp_time;
+
+    if ((command == ISE_MEASURE_MV) && (ise->_filter_samples <= round)) continue;
+    ise->_start(command, duration, false);
+    last = ise;
+  }
+  if (last) last->_gap();
+}
+
+void uFire_ISEGroup::_collect()
+{
+  uFire_ISE *slowest = nullptr;
+
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (!_members[i]->busy()) continue;
+    if (!slowest || (_members[i]->_duration > slowest->_duration)) slowest = _members[i];
+  }
+  if (!slowest) return;
+
+  // the waits go through _delay() so ISE_STATS counts them
+  slowest->_delay(slowest->_duration);
+  while (!update()) slowest->_delay(1);
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef ISE_GROUP_H
+#define ISE_GROUP_H
+
+#include "uFire_ISE.h"
+
+#ifndef ISE_GROUP_MAX
+# define ISE_GROUP_MAX 16 /*!< most probes one group can hold */
+#endif // ifndef ISE_GROUP_MAX
+
+class uFire_ISEGroup /*! Triggers conversions on several probes at once */
+{
+public:
+
+  unsigned long timestamp; /*!< millis() when the last conversions were triggered */
+  bool       add(uFire_ISE *ise);
+  uint8_t    size();
+  uFire_ISE* get(uint8_t index);
+  void       measuremV();
+  void       measureTemp();
+  void       startMeasuremV();
+  void       startMeasureTemp();
+  bool       update();
+  bool       busy();
+
+private:
+
+  uFire_ISE *_members[ISE_GROUP_MAX];
+  uint8_t    _count = 0;
+  void       _trigger(uint8_t command,
+                       uint8_t round);
+  void       _collect();
+};
+
+#endif // ifndef ISE_GROUP_H
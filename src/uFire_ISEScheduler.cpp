@@ -0,0 +1,100 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISEScheduler.h"
+
+bool uFire_ISEScheduler::add(uFire_ISE *ise, unsigned long period, unsigned long temp_period)
+{
+  return _add(ise, ISE_PROBE_MV, period, temp_period);
+}
+
+bool uFire_ISEScheduler::add(uFire_pH *ph, unsigned long period, unsigned long temp_period)
+{
+  return _add(ph, ISE_PROBE_PH, period, temp_period);
+}
+
+bool uFire_ISEScheduler::add(uFire_ORP *orp, unsigned long period, unsigned long temp_period)
+{
+  return _add(orp, ISE_PROBE_ORP, period, temp_period);
+}
+
+void uFire_ISEScheduler::update()
+{
+  unsigned long now = millis();
+
+  // at most one bus operation per call, visiting probes round-robin so a
+  // probe that is converting never holds up the others
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    entry_t &e = _entries[_next];
+
+    _next = (_next + 1) % _count;
+    if (e.ise->busy() ? e.ise->update() : _start(e, now)) return;
+  }
+}
+
+bool uFire_ISEScheduler::_add(uFire_ISE *ise, probe_type_t type, unsigned long period, unsigned long temp_period)
+{
+  if (_count >= ISE_SCHEDULER_MAX) return false;
+
+  entry_t &e = _entries[_count++];
+
+  e.ise         = ise;
+  e.type        = type;
+  e.period      = period;
+  e.temp_period = temp_period;
+  e.next_sample = millis();
+  e.next_temp   = e.next_sample;
+  return true;
+}
+
+bool uFire_ISEScheduler::_start(entry_t &e, unsigned long now)
+{
+  // temperature goes first so pH compensation uses a fresh value
+  if (e.temp_period && ((long)(now - e.next_temp) >= 0))
+  {
+    e.next_temp = ((long)(now - e.next_temp) >= (long)e.temp_period) ? now + e.temp_period : e.next_temp + e.temp_period;
+    e.ise->startMeasureTemp();
+    return true;
+  }
+
+  if (!e.period || ((long)(now - e.next_sample) < 0)) return false;
+
+  e.next_sample = ((long)(now - e.next_sample) >= (long)e.period) ? now + e.period : e.next_sample + e.period;
+  switch (e.type)
+  {
+  case ISE_PROBE_PH:
+    if (e.temp_period) static_cast<uFire_pH *>(e.ise)->startMeasurepH(e.ise->tempC);
+    else static_cast<uFire_pH *>(e.ise)->startMeasurepH();
+    break;
+
+  case ISE_PROBE_ORP:
+    static_cast<uFire_ORP *>(e.ise)->startMeasureORP();
+    break;
+
+  default:
+    e.ise->startMeasuremV();
+  }
+  return true;
+}
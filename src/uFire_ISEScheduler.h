@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef ISE_SCHEDULER_H
+#define ISE_SCHEDULER_H
+
+#include "uFire_ISE.h"
+#include "uFire_pH.h"
+#include "uFire_ORP.h"
+
+#ifndef ISE_SCHEDULER_MAX
+# define ISE_SCHEDULER_MAX 16 /*!< most probes one scheduler can hold */
+#endif // ifndef ISE_SCHEDULER_MAX
+
+class uFire_ISEScheduler /*! Samples many probes at their own rates without blocking */
+{
+public:
+
+  bool add(uFire_ISE    *ise,
+           unsigned long period,
+           unsigned long temp_period=0);
+  bool add(uFire_pH     *ph,
+           unsigned long period,
+           unsigned long temp_period=0);
+  bool add(uFire_ORP    *orp,
+           unsigned long period,
+           unsigned long temp_period=0);
+  void update();
+
+private:
+
+  enum probe_type_t { ISE_PROBE_MV, ISE_PROBE_PH, ISE_PROBE_ORP };
+
+  struct entry_t
+  {
+    uFire_ISE    *ise;
+    probe_type_t  type;
+    unsigned long period;
+    unsigned long temp_period;
+    unsigned long next_sample;
+    unsigned long next_temp;
+  };
+
+  entry_t _entries[ISE_SCHEDULER_MAX];
+  uint8_t _count = 0;
+  uint8_t _next  = 0;
+  bool    _add(uFire_ISE    *ise,
+               probe_type_t  type,
+               unsigned long period,
+               unsigned long temp_period);
+  bool    _start(entry_t      &e,
+                 unsigned long now);
+};
+
+#endif // ifndef ISE_SCHEDULER_H
@@ -0,0 +1,325 @@
+#include "uFire_ISE_Command.h"
+
+#if defined(ISE_COMMAND_AVAILABLE)
+
+// next whitespace delimited token in [*p, end), without copying
+size_t uFire_ISE_CommandBase::_token(const char **p, const char *end, const char **token)
+{
+  const char *s = *p;
+
+  while ((s < end) && *s && isspace(*s)) s++;
+  const char *e = s;
+
+  while ((e < end) && *e && !isspace(*e)) e++;
+  *token = s;
+  *p     = e;
+  return e - s;
+}
+
+// next ';' separated command of a batch in [*p, end) and its parameter;
+// false once the batch is used up
+bool uFire_ISE_CommandBase::_next(const char **p, const char *end, const char **cmd, size_t *cmd_len,
+                                  const char **parameter, size_t *parameter_len)
+{
+  if (*p >= end) return false;
+
+  const char *next = (const char *)memchr(*p, ';', end - *p);
+
+  if (!next) next = end;
+  *cmd_len       = _token(p, next, cmd);
+  *parameter_len = _token(p, next, parameter);
+  *p             = (next < end) ? next + 1 : end;
+  return true;
+}
+
+float uFire_ISE_CommandBase::_to_float(const char *s, size_t len)
+{
+  char buffer[16];
+
+  if (len >= sizeof(buffer)) len = sizeof(buffer) - 1;
+  memcpy(buffer, s, len);
+  buffer[len] = '\0';
+  return atof(buffer);
+}
+
+String uFire_ISE_CommandBase::_to_string(const char *output, size_t len)
+{
+  String response;
+
+  // byte by byte, binary codecs can contain NUL
+  response.reserve(len);
+  for (size_t i = 0; i < len; i++) response += output[i];
+  return response;
+}
+
+
+void uFire_ISE_CommandBase::_begin(uFire_ISE *sensor, const ise_command_t *commands)
+{
+  _sensor          = sensor;
+  _commands        = commands;
+  emptyPlaceholder = "-";
+}
+
+const ise_command_t * uFire_ISE_CommandBase::_find(const char *cmd, size_t len)
+{
+  for (const ise_command_t *c = _commands; c && c->name; c++)
+  {
+    if ((strncmp(c->name, cmd, len) == 0) && (c->name[len] == '\0')) return c;
+  }
+  return NULL;
+}
+
+bool uFire_ISE_CommandBase::_run(JsonObject doc, const char *request, size_t len, bool collected)
+{
+  const char *end   = request + len;
+  const char *cmd;
+  const char *parameter;
+  size_t      cmd_len;
+  size_t      parameter_len;
+  uint8_t     reads = 0;
+  uint8_t     count = 0;
+  bool        found = false;
+
+  // several register reads in a batch are served by one sweep of the
+  // mirrored registers, like readData(), instead of a transaction each
+  for (const char *p = request; _next(&p, end, &cmd, &cmd_len, &parameter, &parameter_len);)
+  {
+    const ise_command_t *c = _find(cmd, cmd_len);
+
+    if (c) count++;
+    if (c && c->registers) reads++;
+  }
+
+  // a batch that does not fit the response is rejected before anything in
+  // it runs, rather than silently dropping calibration or EEPROM writes
+  if (count > ISE_COMMAND_BATCH_MAX)
+  {
+    value = -1;
+    return false;
+  }
+  if ((reads > 1) && (_sensor->_shadow_valid != _sensor->_shadow_mask(ISE_SHADOW_START, ISE_SHADOW_SIZE)))
+  {
+    _sensor->_shadow_refresh();
+  }
+
+  while (_next(&request, end, &cmd, &cmd_len, &parameter, &parameter_len))
+  {
+    const ise_command_t *c = _find(cmd, cmd_len);
+
+    if (!c) continue;
+
+    // after a shared conversion window the values are already read
+    ise_command_handler_t handler = (collected && c->conversion) ? c->result : c->handler;
+    double                result  = handler(_sensor, parameter_len ? _to_float(parameter, parameter_len) : NAN);
+
+    value = result;
+    if ((c->kind == ISE_COMMAND_OPTIONAL) && isnan(result)) doc[c->name] = emptyPlaceholder.c_str();
+    else if (c->kind == ISE_COMMAND_BOOL) doc[c->name] = result != 0;
+    else if (c->kind == ISE_COMMAND_ECHO) doc[c->name] = c->name;
+    else doc[c->name] = result;
+    found = true;
+  }
+
+  if (!found) value = -1;
+  return found;
+}
+
+#endif // if defined(ISE_COMMAND_AVAILABLE)
+
+static double _rounded(float value)
+{
+  return floor(value * 100.0 + 0.5) / 100.0;
+}
+
+// handlers shared by every sensor type
+static double _reset(uFire_ISE *ise, float)
+{
+  ise->reset();
+  return 0;
+}
+
+static double _connected(uFire_ISE *ise, float)
+{
+  return ise->connected();
+}
+
+static double _temp(uFire_ISE *ise, float)
+{
+  return ise->measureTemp();
+}
+
+static double _temp_result(uFire_ISE *ise, float)
+{
+  return ise->tempC;
+}
+
+static double _single(uFire_ISE *ise, float parameter)
+{
+  if (!isnan(parameter))
+  {
+    ise->calibrateSingle(parameter);
+  }
+
+  return ise->getCalibrateOffset();
+}
+
+static double ise_measure(uFire_ISE *ise, float)
+{
+  return _rounded(ise->measuremV());
+}
+
+static double ise_high_ref(uFire_ISE *ise, float parameter)
+{
+  if (!isnan(parameter))
+  {
+    ise->calibrateProbeHigh(parameter);
+  }
+
+  return ise->getCalibrateHighReference();
+}
+
+static double ise_high_read(uFire_ISE *ise, float)
+{
+  return ise->getCalibrateHighReading();
+}
+
+static double ise_low_ref(uFire_ISE *ise, float parameter)
+{
+  if (!isnan(parameter))
+  {
+    ise->calibrateProbeLow(parameter);
+  }
+
+  return ise->getCalibrateLowReference();
+}
+
+static double ise_low_read(uFire_ISE *ise, float)
+{
+  return ise->getCalibrateLowReading();
+}
+
+static double ise_result(uFire_ISE *ise, float)
+{
+  return _rounded(ise->mV);
+}
+
+const ise_command_t ise_commands_ISE[] = {
+  { "i",    ISE_COMMAND_NUMBER,   false, ISE_MEASURE_MV,   ise_measure,    ise_result },
+  { "ihrf", ISE_COMMAND_OPTIONAL, true,  0,                ise_high_ref,   NULL },
+  { "ihr",  ISE_COMMAND_OPTIONAL, true,  0,                ise_high_read,  NULL },
+  { "ilrf", ISE_COMMAND_OPTIONAL, true,  0,                ise_low_ref,    NULL },
+  { "ilr",  ISE_COMMAND_OPTIONAL, true,  0,                ise_low_read,   NULL },
+  { "is",   ISE_COMMAND_OPTIONAL, true,  0,                _single,        NULL },
+  { "ic",   ISE_COMMAND_BOOL,     false, 0,                _connected,     NULL },
+  { "ir",   ISE_COMMAND_ECHO,     false, 0,                _reset,         NULL },
+  { "it",   ISE_COMMAND_NUMBER,   false, ISE_MEASURE_TEMP, _temp,          _temp_result },
+  { NULL,   0,                    false, 0,                NULL,           NULL }
+};
+
+static double ph_measure(uFire_ISE *ise, float parameter)
+{
+  uFire_pH *ph = static_cast<uFire_pH *>(ise);
+
+  return _rounded(isnan(parameter) ? ph->measurepH() : ph->measurepH(parameter));
+}
+
+static double ph_single(uFire_ISE *ise, float parameter)
+{
+  uFire_pH *ph = static_cast<uFire_pH *>(ise);
+
+  if (!isnan(parameter))
+  {
+    ph->calibrateSingle(parameter);
+  }
+
+  return ph->getCalibrateOffset();
+}
+
+static double ph_high_ref(uFire_ISE *ise, float parameter)
+{
+  uFire_pH *ph = static_cast<uFire_pH *>(ise);
+
+  if (!isnan(parameter))
+  {
+    ph->calibrateProbeHigh(parameter);
+  }
+
+  return ph->getCalibrateHighReference();
+}
+
+static double ph_high_read(uFire_ISE *ise, float)
+{
+  return static_cast<uFire_pH *>(ise)->getCalibrateHighReading();
+}
+
+static double ph_low_ref(uFire_ISE *ise, float parameter)
+{
+  uFire_pH *ph = static_cast<uFire_pH *>(ise);
+
+  if (!isnan(parameter))
+  {
+    ph->calibrateProbeLow(parameter);
+  }
+
+  return ph->getCalibrateLowReference();
+}
+
+static double ph_low_read(uFire_ISE *ise, float)
+{
+  return static_cast<uFire_pH *>(ise)->getCalibrateLowReading();
+}
+
+static double ph_result(uFire_ISE *ise, float)
+{
+  return _rounded(static_cast<uFire_pH *>(ise)->pH);
+}
+
+const ise_command_t ise_commands_pH[] = {
+  { "ph",   ISE_COMMAND_NUMBER,   false, ISE_MEASURE_MV,   ph_measure,     ph_result },
+  { "phrf", ISE_COMMAND_OPTIONAL, true,  0,                ph_high_ref,    NULL },
+  { "phr",  ISE_COMMAND_OPTIONAL, true,  0,                ph_high_read,   NULL },
+  { "plrf", ISE_COMMAND_OPTIONAL, true,  0,                ph_low_ref,     NULL },
+  { "plr",  ISE_COMMAND_OPTIONAL, true,  0,                ph_low_read,    NULL },
+  { "ps",   ISE_COMMAND_OPTIONAL, true,  0,                ph_single,      NULL },
+  { "pc",   ISE_COMMAND_BOOL,     false, 0,                _connected,     NULL },
+  { "pr",   ISE_COMMAND_ECHO,     false, 0,                _reset,         NULL },
+  { "pt",   ISE_COMMAND_NUMBER,   false, ISE_MEASURE_TEMP, _temp,          _temp_result },
+  { NULL,   0,                    false, 0,                NULL,           NULL }
+};
+
+static double orp_measure(uFire_ISE *ise, float)
+{
+  return _rounded(ise->measuremV());
+}
+
+static double orp_potential(uFire_ISE *ise, float parameter)
+{
+  uFire_ORP *orp = static_cast<uFire_ORP *>(ise);
+
+  if (!isnan(parameter))
+  {
+    orp->setProbePotential(parameter);
+  }
+
+  return orp->getProbePotential();
+}
+
+static double orp_temp(uFire_ISE *ise, float)
+{
+  return floor(ise->measureTemp());
+}
+
+static double orp_temp_result(uFire_ISE *ise, float)
+{
+  return floor(ise->tempC);
+}
+
+const ise_command_t ise_commands_ORP[] = {
+  { "o",    ISE_COMMAND_NUMBER,   false, ISE_MEASURE_MV,   orp_measure,    ise_result },
+  { "oo",   ISE_COMMAND_OPTIONAL, true,  0,                _single,        NULL },
+  { "or",   ISE_COMMAND_ECHO,     false, 0,                _reset,         NULL },
+  { "op",   ISE_COMMAND_OPTIONAL, false, 0,                orp_potential,  NULL },
+  { "ot",   ISE_COMMAND_NUMBER,   false, ISE_MEASURE_TEMP, orp_temp,       orp_temp_result },
+  { "oc",   ISE_COMMAND_BOOL,     false, 0,                _connected,     NULL },
+  { NULL,   0,                    false, 0,                NULL,           NULL }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "uFire_pH.h"
+#include "uFire_ORP.h"
+
+enum { ISE_COMMAND_NUMBER, ISE_COMMAND_OPTIONAL, ISE_COMMAND_BOOL, ISE_COMMAND_ECHO };
+
+// parameter is NAN when the command has none
+typedef double (*ise_command_handler_t)(uFire_ISE *, float parameter);
+
+typedef struct ise_command_t    /*! one command; tables end with a NULL name */
+{
+  const char           *name;    /*!< command, also the response key */
+  uint8_t               kind;    /*!< how the handler's value is written */
+  bool                  registers;  /*!< reads the mirrored calibration registers */
+  uint8_t               conversion; /*!< ISE_MEASURE_MV/_TEMP it waits on, 0 for none */
+  ise_command_handler_t handler;
+  ise_command_handler_t result;     /*!< value from a conversion already collected */
+} ise_command_t;
+
+extern const ise_command_t ise_commands_ISE[]; /*!< i, it, ic, ir, is, ihrf, ihr, ilrf, ilr */
+extern const ise_command_t ise_commands_pH[];  /*!< ph, pt, pc, pr, ps, phrf, phr, plrf, plr */
+extern const ise_command_t ise_commands_ORP[]; /*!< o, ot, oc, or, oo, op */
+
+// the command table for each sensor type
+template<class Sensor>
+struct ise_command_table;
+template<>
+struct ise_command_table<uFire_ISE>{ static const ise_command_t *commands() { return ise_commands_ISE; } };
+template<>
+struct ise_command_table<uFire_pH>{ static const ise_command_t *commands() { return ise_commands_pH; } };
+template<>
+struct ise_command_table<uFire_ORP>{ static const ise_command_t *commands() { return ise_commands_ORP; } };
+
+#ifdef __has_include
+#if __has_include("ArduinoJson.h")
+#include <ArduinoJson.h>
+#define ISE_COMMAND_AVAILABLE
+
+#ifndef ISE_COMMAND_OUTPUT_SIZE
+# define ISE_COMMAND_OUTPUT_SIZE 160 /*!< bytes for one response from process(String) */
+#endif // ifndef ISE_COMMAND_OUTPUT_SIZE
+
+#ifndef ISE_COMMAND_BATCH_MAX
+# define ISE_COMMAND_BATCH_MAX 8    /*!< commands in one batch, e.g. "ph 25; pt; phrf; plrf"; longer batches are rejected */
+#endif // ifndef ISE_COMMAND_BATCH_MAX
+
+// serializer policies; any type with a matching static write() can be used
+struct ise_json_codec
+{
+  static size_t write(JsonDocument &doc, char *output, size_t size) { return serializeJson(doc, output, size); }
+};
+
+struct ise_msgpack_codec
+{
+  static size_t write(JsonDocument &doc, char *output, size_t size) { return serializeMsgPack(doc, output, size); }
+};
+
+class uFire_ISE_CommandBase
+{
+public:
+  float value;
+  String emptyPlaceholder;
+
+protected:
+  uFire_ISE           *_sensor   = nullptr;
+  const ise_command_t *_commands = nullptr;
+  void                 _begin(uFire_ISE           *sensor,
+                              const ise_command_t *commands);
+  bool                 _run(JsonObject  doc,
+                            const char *request,
+                            size_t      len,
+                            bool        collected=false);
+  const ise_command_t* _find(const char *cmd,
+                             size_t      len);
+  static size_t        _token(const char **p,
+                              const char  *end,
+                              const char **token);
+  static bool          _next(const char **p,
+                             const char  *end,
+                             const char **cmd,
+                             size_t      *cmd_len,
+                             const char **parameter,
+                             size_t      *parameter_len);
+  static float         _to_float(const char *s,
+                                 size_t      len);
+  static String        _to_string(const char *output,
+                                  size_t      len);
+};
+
+// A text command frontend for one probe. Parsing, dispatch and the response
+// document are shared by every instantiation; only Codec::write() differs.
+// Commands separated by ';' run in order and answer in one document.
+template<class Sensor, class Codec>
+class uFire_ISE_Command : public uFire_ISE_CommandBase
+{
+public:
+  void begin(Sensor *sensor, uint8_t address=ISE_PROBE_I2C)
+  {
+    sensor->begin(address);
+    _begin(sensor, ise_command_table<Sensor>::commands());
+  }
+
+  size_t process(const char *request, size_t len, char *output, size_t size)
+  {
+    // keys and strings are linked, not copied, so one slot per command
+    StaticJsonDocument<JSON_OBJECT_SIZE(ISE_COMMAND_BATCH_MAX)> doc;
+
+    if (!_run(doc.template to<JsonObject>(), request, len))
+    {
+      if (size) output[0] = '\0';
+      return 0;
+    }
+    return Codec::write(doc, output, size);
+  }
+
+  String process(String request)
+  {
+    char output[ISE_COMMAND_OUTPUT_SIZE];
+
+    return _to_string(output, process(request.c_str(), request.length(), output, sizeof(output)));
+  }
+};
+
+#endif // if __has_include("ArduinoJson.h")
+#endif // ifdef __has_include
@@ -0,0 +1,178 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <math.h>
+#include "uFire_ISE_Convert.h"
+#include "uFire_ISE_Constants.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(ARDUINO)
+# define ISE_CONVERT_AVX2
+# include <immintrin.h>
+#endif // if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(ARDUINO)
+
+float ise_convert_pH(float mV, float tempC)
+{
+  if (mV == -1) return -1;
+
+  float pH = fabs(7.0 - (mV / PROBE_MV_TO_PH));
+
+  // Determine the temperature correction; float functions named explicitly so
+  // the precision doesn't depend on which overloads <math.h> provides
+  uint8_t distance_from_7  = fabsf(7 - roundf(pH));
+  uint8_t distance_from_25 = floorf(fabsf(25 - roundf(tempC)) / 10);
+  float   temp_multiplier  = (distance_from_25 * distance_from_7) * TEMP_CORRECTION_FACTOR;
+
+  if ((pH >= 8.0) && (tempC >= 35))
+  {
+    // negative
+    temp_multiplier *= -1;
+  }
+  if ((pH <= 6.0) && (tempC <= 15))
+  {
+    // negative
+    temp_multiplier *= -1;
+  }
+  pH += temp_multiplier;
+
+  if ((pH <= 0.0) || (pH > 14.0) || isinf(pH) || isnan(pH)) return -1;
+
+  return pH;
+}
+
+float ise_convert_Eh(float mV, uint32_t potential)
+{
+  if (isinf(mV) || isnan(mV)) return -1;
+
+  return mV + potential;
+}
+
+#if defined(ISE_CONVERT_AVX2)
+
+// roundf(): truncate, then step away from zero when the dropped part is at
+// least one half; x - trunc(x) is exact, unlike x + 0.5
+__attribute__((target("avx2"))) static inline __m128 _roundf_avx2(__m128 x)
+{
+  __m128 r    = _mm_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 up   = _mm_cmpge_ps(_mm_andnot_ps(sign, _mm_sub_ps(x, r)), _mm_set1_ps(0.5f));
+
+  return _mm_add_ps(r, _mm_and_ps(up, _mm_or_ps(_mm_and_ps(sign, x), _mm_set1_ps(1.0f))));
+}
+
+// Four samples per pass. Each step is done in the precision ise_convert_pH()
+// uses, double for the division and correction factor, and the uint8_t
+// distances truncate through int32 the way x86 scalar code does, so every
+// lane matches the scalar result exactly.
+__attribute__((target("avx2"))) static size_t _convert_pH_avx2(const float *mV, const float *tempC, float *pH, size_t n)
+{
+  const __m256d mv_ph  = _mm256_set1_pd(PROBE_MV_TO_PH);
+  const __m256d seven  = _mm256_set1_pd(7.0);
+  const __m256d factor = _mm256_set1_pd(TEMP_CORRECTION_FACTOR);
+  const __m128i low8   = _mm_set1_epi32(0xFF);
+  const __m128  sign   = _mm_set1_ps(-0.0f);
+  const __m128  minus1 = _mm_set1_ps(-1.0f);
+  size_t i             = 0;
+
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128 mv = _mm_loadu_ps(mV + i);
+    __m128 t  = _mm_loadu_ps(tempC + i);
+
+    // pH = fabs(7.0 - (mv / PROBE_MV_TO_PH)), stored as float
+    __m256d x = _mm256_sub_pd(seven, _mm256_div_pd(_mm256_cvtps_pd(mv), mv_ph));
+    __m128  p = _mm_andnot_ps(sign, _mm256_cvtpd_ps(x));
+
+    __m128  d7  = _mm_andnot_ps(sign, _mm_sub_ps(_mm_set1_ps(7.0f), _roundf_avx2(p)));
+    __m128  d25 = _mm_floor_ps(_mm_div_ps(_mm_andnot_ps(sign, _mm_sub_ps(_mm_set1_ps(25.0f), _roundf_avx2(t))),
+                                          _mm_set1_ps(10.0f)));
+    __m128i i7  = _mm_and_si128(_mm_cvttps_epi32(d7), low8);
+    __m128i i25 = _mm_and_si128(_mm_cvttps_epi32(d25), low8);
+    __m128  tm  = _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm_mullo_epi32(i25, i7)), factor));
+
+    __m128 neg = _mm_or_ps(_mm_and_ps(_mm_cmpge_ps(p, _mm_set1_ps(8.0f)), _mm_cmpge_ps(t, _mm_set1_ps(35.0f))),
+                           _mm_and_ps(_mm_cmple_ps(p, _mm_set1_ps(6.0f)), _mm_cmple_ps(t, _mm_set1_ps(15.0f))));
+    __m128 r   = _mm_add_ps(p, _mm_xor_ps(tm, _mm_and_ps(neg, sign)));
+
+    // ordered compares are false for NaN, and exclude +-inf by range
+    __m128 ok = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(r, _mm_setzero_ps()), _mm_cmple_ps(r, _mm_set1_ps(14.0f))),
+                           _mm_cmpneq_ps(mv, minus1));
+    _mm_storeu_ps(pH + i, _mm_blendv_ps(minus1, r, ok));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) static size_t _convert_Eh_avx2(const float *mV, float potential, float *Eh, size_t n)
+{
+  const __m256 sign   = _mm256_set1_ps(-0.0f);
+  const __m256 inf    = _mm256_set1_ps(INFINITY);
+  const __m256 offset = _mm256_set1_ps(potential);
+  const __m256 minus1 = _mm256_set1_ps(-1.0f);
+  size_t i            = 0;
+
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256 mv     = _mm256_loadu_ps(mV + i);
+    __m256 finite = _mm256_cmp_ps(_mm256_andnot_ps(sign, mv), inf, _CMP_LT_OQ);
+    _mm256_storeu_ps(Eh + i, _mm256_blendv_ps(minus1, _mm256_add_ps(mv, offset), finite));
+  }
+  return i;
+}
+
+static bool _has_avx2()
+{
+  static int8_t avx2 = -1;
+
+  if (avx2 < 0) avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  return avx2;
+}
+
+#endif // if defined(ISE_CONVERT_AVX2)
+
+void convert_pH(const float *mV, const float *tempC, float *pH, size_t n)
+{
+  size_t i = 0;
+
+#if defined(ISE_CONVERT_AVX2)
+  if (_has_avx2()) i = _convert_pH_avx2(mV, tempC, pH, n);
+#endif // if defined(ISE_CONVERT_AVX2)
+
+  for (; i < n; i++)
+  {
+    pH[i] = ise_convert_pH(mV[i], tempC[i]);
+  }
+}
+
+void convert_Eh(const float *mV, uint32_t potential, float *Eh, size_t n)
+{
+  size_t i = 0;
+
+#if defined(ISE_CONVERT_AVX2)
+  if (_has_avx2()) i = _convert_Eh_avx2(mV, potential, Eh, n);
+#endif // if defined(ISE_CONVERT_AVX2)
+
+  for (; i < n; i++)
+  {
+    Eh[i] = ise_convert_Eh(mV[i], potential);
+  }
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef ISE_CONVERT_H
+#define ISE_CONVERT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Offline conversion of recorded mV, e.g. ise_sample_t streams, without a
+// device. The batch functions give the same results, bit for bit, as the
+// single-sample ones, which are what uFire_pH and uFire_ORP use themselves.
+
+float ise_convert_pH(float    mV,
+                     float    tempC);
+float ise_convert_Eh(float    mV,
+                     uint32_t potential);
+
+void  convert_pH(const float *mV,
+                 const float *tempC,
+                 float       *pH,
+                 size_t       n);
+void  convert_Eh(const float *mV,
+                 uint32_t     potential,
+                 float       *Eh,
+                 size_t       n);
+
+#endif // ifndef ISE_CONVERT_H
@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISE_FileCache.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+# include <stdio.h>
+# include <string.h>
+
+static char _directory[ISE_FILE_CACHE_DIRECTORY_MAX] = ".";
+
+static void _path(uint8_t address, char *path, size_t len)
+{
+  snprintf(path, len, "%s/ise-%02x.cache", _directory, address);
+}
+
+bool ise_file_cache_directory(const char *directory)
+{
+  // a truncated path would name some other directory, so keep the old one
+  if (!directory || (strlen(directory) >= sizeof(_directory))) return false;
+
+  strcpy(_directory, directory);
+  return true;
+}
+
+bool ise_file_cache_load(uint8_t address, uint8_t *buf, size_t len)
+{
+  char path[256];
+
+  _path(address, path, sizeof(path));
+  FILE *f = fopen(path, "rb");
+
+  if (!f) return false;
+
+  size_t n = fread(buf, 1, len, f);
+
+  fclose(f);
+  return n == len;
+}
+
+bool ise_file_cache_store(uint8_t address, const uint8_t *buf, size_t len)
+{
+  char path[256];
+  char tmp[260];
+
+  // write a temporary file and rename it so a crash never leaves half a record
+  _path(address, path, sizeof(path));
+  snprintf(tmp, sizeof(tmp), "%s.new", path);
+  FILE *f = fopen(tmp, "wb");
+
+  if (!f) return false;
+
+  bool ok = fwrite(buf, 1, len, f) == len;
+
+  ok = (fclose(f) == 0) && ok;
+  return ok && (rename(tmp, path) == 0);
+}
+
+#endif // if defined(__linux__) && !defined(ARDUINO)
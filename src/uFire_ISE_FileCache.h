@@ -0,0 +1,47 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Register cache storage for warmStart()/persistCache() on Linux hosts.
+// Each probe is kept in its own file, <directory>/ise-<address>.cache.
+// The directory is copied, so the caller's string need not outlive the call.
+
+#ifndef ISE_FILECACHE_H
+#define ISE_FILECACHE_H
+
+#include "uFire_ISE.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#define ISE_FILE_CACHE_DIRECTORY_MAX 224 /*!< longest directory, leaves room for the file name in a 256-byte path */
+
+bool ise_file_cache_directory(const char *directory);
+bool ise_file_cache_load(uint8_t  address,
+                         uint8_t *buf,
+                         size_t   len);
+bool ise_file_cache_store(uint8_t        address,
+                          const uint8_t *buf,
+                          size_t         len);
+
+#endif // if defined(__linux__) && !defined(ARDUINO)
+#endif // ifndef ISE_FILECACHE_H
@@ -0,0 +1,211 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISE_Frame.h"
+
+uint16_t ise_crc16(const uint8_t *buf, size_t len)
+{
+  // CRC-16/CCITT-FALSE, polynomial 0x1021
+  uint16_t crc = 0xFFFF;
+
+  while (len--)
+  {
+    crc ^= (uint16_t)*buf++ << 8;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+size_t ise_frame_encode(const ise_frame_t &frame, uint8_t *output)
+{
+  uint8_t  raw[ISE_FRAME_SIZE];
+  uint16_t crc;
+
+  raw[0] = frame.command;
+  raw[1] = frame.address;
+  raw[2] = frame.sequence;
+  raw[3] = frame.sequence >> 8;
+  memcpy(&raw[4], &frame.value, 4);
+  crc    = ise_crc16(raw, 8);
+  raw[8] = crc;
+  raw[9] = crc >> 8;
+
+  // COBS: each code byte is the distance to the next zero
+  size_t code = 0;
+  size_t n    = 1;
+
+  for (uint8_t i = 0; i < ISE_FRAME_SIZE; i++)
+  {
+    if (raw[i])
+    {
+      output[n++] = raw[i];
+    }
+    else
+    {
+      output[code] = n - code;
+      code         = n++;
+    }
+  }
+  output[code] = n - code;
+  output[n++]  = 0;
+  return n;
+}
+
+bool ise_frame_decode(const uint8_t *input, size_t len, ise_frame_t &frame)
+{
+  uint8_t raw[ISE_FRAME_SIZE];
+  size_t  n = 0;
+  size_t  i = 0;
+
+  while (i < len)
+  {
+    uint8_t code = input[i++];
+
+    if (!code || (i + code - 1 > len)) return false;
+
+    for (uint8_t j = 1; j < code; j++)
+    {
+      if (n >= ISE_FRAME_SIZE) return false;
+      raw[n++] = input[i++];
+    }
+    if ((code < 0xFF) && (i < len))
+    {
+      if (n >= ISE_FRAME_SIZE) return false;
+      raw[n++] = 0;
+    }
+  }
+
+  if (n != ISE_FRAME_SIZE) return false;
+
+  if (ise_crc16(raw, 8) != (raw[8] | (raw[9] << 8))) return false;
+
+  frame.command  = raw[0];
+  frame.address  = raw[1];
+  frame.sequence = raw[2] | (raw[3] << 8);
+  memcpy(&frame.value, &raw[4], 4);
+  return true;
+}
+
+bool uFire_ISE_FrameDecoder::push(uint8_t byte)
+{
+  if (byte)
+  {
+    // an overlong frame keeps _len past the buffer until the delimiter
+    if (_len < sizeof(_buffer)) _buffer[_len] = byte;
+    if (_len <= sizeof(_buffer)) _len++;
+    return false;
+  }
+
+  if (!_len) return false;
+
+  bool ok = (_len <= sizeof(_buffer)) && ise_frame_decode(_buffer, _len, frame);
+
+  if (!ok) errors++;
+  _len = 0;
+  return ok;
+}
+
+void uFire_ISE_FrameBase::_begin(uFire_ISE *sensor, const ise_command_t *commands)
+{
+  _sensor   = sensor;
+  _commands = commands;
+  _count    = 0;
+  while (commands[_count].name) _count++;
+}
+
+size_t uFire_ISE_FrameBase::process(const uint8_t *input, size_t len, uint8_t *output, size_t size)
+{
+  size_t written = 0;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    if (!_decoder.push(input[i])) continue;
+
+    ise_frame_t &request = _decoder.frame;
+
+    if ((request.address != _sensor->_address) && (request.address != ISE_FRAME_ADDRESS_ANY)) continue;
+
+    ise_frame_t response = { request.command, _sensor->_address, request.sequence, 0 };
+
+    if (request.command < _count)
+    {
+      const ise_command_t &c = _commands[request.command];
+
+      response.value = c.handler(_sensor, request.value);
+      if (c.kind == ISE_COMMAND_ECHO) response.value = 0;
+      else if (c.kind == ISE_COMMAND_BOOL) response.value = response.value != 0;
+    }
+    else if (request.command == ISE_FRAME_STREAM_START)
+    {
+      _streaming = true;
+      _sensor->startContinuous(&_samples);
+    }
+    else if (request.command == ISE_FRAME_STREAM_STOP)
+    {
+      _streaming = false;
+      _sensor->stopContinuous();
+    }
+    else
+    {
+      response.command = ISE_FRAME_ERROR;
+      response.value   = request.command;
+    }
+
+    if (size - written < ISE_FRAME_ENCODED_SIZE)
+    {
+      dropped++;
+      continue;
+    }
+    written += ise_frame_encode(response, output + written);
+  }
+  return written;
+}
+
+size_t uFire_ISE_FrameBase::stream(uint8_t *output, size_t size)
+{
+  ise_sample_t samples[8];
+  size_t       written = 0;
+
+  if (_streaming) _sensor->update();
+
+  while (size - written >= ISE_FRAME_ENCODED_SIZE)
+  {
+    size_t room = (size - written) / ISE_FRAME_ENCODED_SIZE;
+    size_t n    = _samples.drain(samples, room < 8 ? room : 8);
+
+    if (!n) break;
+
+    for (size_t i = 0; i < n; i++)
+    {
+      ise_frame_t frame = { ISE_FRAME_SAMPLE, _sensor->_address, _sequence++,
+                            isnan(samples[i].derived) ? samples[i].mV : samples[i].derived };
+
+      written += ise_frame_encode(frame, output + written);
+    }
+  }
+  return written;
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef ISE_FRAME_H
+#define ISE_FRAME_H
+
+#include "uFire_ISE_Command.h"
+#include "uFire_ISE_SampleBuffer.h"
+
+// A frame is 10 bytes, little-endian: command, probe address, 16-bit
+// sequence, float value, then a CRC-16/CCITT-FALSE of the first 8 bytes. It
+// is COBS encoded and ends with a 0x00 delimiter, so a receiver can pick up
+// at any frame boundary. Request commands are indexes into the probe's
+// command table (ise_commands_pH etc.) with the parameter as the value, NAN
+// for none; the response echoes command and sequence with the result.
+#define ISE_FRAME_SIZE 10              /*!< command, address, sequence, value, CRC-16 */
+#define ISE_FRAME_ENCODED_SIZE 12      /*!< with the COBS code byte and delimiter */
+#define ISE_FRAME_ADDRESS_ANY 0x00     /*!< request address every frontend accepts */
+#define ISE_FRAME_SAMPLE 0x80          /*!< streamed sample, value is pH, Eh or mV */
+#define ISE_FRAME_STREAM_START 0x81    /*!< start streaming samples */
+#define ISE_FRAME_STREAM_STOP 0x82     /*!< stop streaming samples */
+#define ISE_FRAME_ERROR 0xFF           /*!< response to an unknown command, value is its id */
+
+typedef struct ise_frame_t    /*! one decoded frame */
+{
+  uint8_t  command;
+  uint8_t  address;
+  uint16_t sequence;
+  float    value;
+} ise_frame_t;
+
+uint16_t ise_crc16(const uint8_t *buf,
+                   size_t         len);
+size_t   ise_frame_encode(const ise_frame_t &frame,
+                          uint8_t           *output);
+bool     ise_frame_decode(const uint8_t *input,
+                          size_t         len,
+                          ise_frame_t   &frame);
+
+class uFire_ISE_FrameDecoder    /*! reassembles frames from a byte stream */
+{
+public:
+
+  ise_frame_t frame;      /*!< last frame decoded */
+  uint32_t    errors = 0; /*!< frames dropped for length or CRC */
+  bool        push(uint8_t byte);
+
+private:
+
+  uint8_t _buffer[ISE_FRAME_ENCODED_SIZE];
+  uint8_t _len = 0;
+};
+
+class uFire_ISE_FrameBase
+{
+public:
+
+  uint32_t dropped = 0; /*!< responses that did not fit the output */
+  size_t   process(const uint8_t *input,
+                   size_t         len,
+                   uint8_t       *output,
+                   size_t         size);
+  size_t   stream(uint8_t *output,
+                  size_t   size);
+
+protected:
+
+  uFire_ISE             *_sensor   = nullptr;
+  const ise_command_t   *_commands = nullptr;
+  uint8_t                _count    = 0;
+  bool                   _streaming = false;
+  uint16_t               _sequence  = 0;
+  uFire_ISE_FrameDecoder _decoder;
+  uFire_ISE_SampleBuffer _samples;
+  void                   _begin(uFire_ISE           *sensor,
+                                const ise_command_t *commands);
+};
+
+// Binary frontend for one probe. process() answers request frames; with
+// streaming started, stream() sends each continuous sample as a frame
+// without a request.
+template<class Sensor>
+class uFire_ISE_Frame : public uFire_ISE_FrameBase
+{
+public:
+  void begin(Sensor *sensor, uint8_t address=ISE_PROBE_I2C)
+  {
+    sensor->begin(address);
+    _begin(sensor, ise_command_table<Sensor>::commands());
+  }
+};
+
+typedef uFire_ISE_Frame<uFire_pH>  uFire_pH_Frame;
+typedef uFire_ISE_Frame<uFire_ORP> uFire_ORP_Frame;
+
+#endif // ifndef ISE_FRAME_H
@@ -0,0 +1,171 @@
+#include "uFire_ISE_Router.h"
+
+#if defined(ISE_COMMAND_AVAILABLE)
+
+bool uFire_ISE_RouterBase::add(uFire_ISE *ise, const char *name)
+{
+  return _add(ise, ISE_PROBE_MV, ise_commands_ISE, name);
+}
+
+bool uFire_ISE_RouterBase::add(uFire_pH *ph, const char *name)
+{
+  return _add(ph, ISE_PROBE_PH, ise_commands_pH, name);
+}
+
+bool uFire_ISE_RouterBase::add(uFire_ORP *orp, const char *name)
+{
+  return _add(orp, ISE_PROBE_ORP, ise_commands_ORP, name);
+}
+
+uint8_t uFire_ISE_RouterBase::size()
+{
+  return _count;
+}
+
+bool uFire_ISE_RouterBase::_add(uFire_ISE *ise, uint8_t type, const ise_command_t *commands, const char *name)
+{
+  static const char hex[] = "0123456789abcdef";
+
+  if (!ise || (_count >= ISE_ROUTER_MAX)) return false;
+
+  // two entries on one address would be the same probe triggered twice
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if ((_entries[i].ise == ise) || (_entries[i].ise->_address == ise->_address)) return false;
+  }
+
+  entry_t &e = _entries[_count++];
+
+  e.ise      = ise;
+  e.type     = type;
+  e.commands = commands;
+  e.name     = name;
+  e.label[0] = '0';
+  e.label[1] = 'x';
+  e.label[2] = hex[(ise->_address >> 4) & 0x0F];
+  e.label[3] = hex[ise->_address & 0x0F];
+  e.label[4] = '\0';
+  return true;
+}
+
+bool uFire_ISE_RouterBase::_match(const entry_t &e, const char *target, size_t len)
+{
+  if (e.name && (strlen(e.name) == len) && !strncmp(e.name, target, len)) return true;
+
+  // otherwise an address, decimal or 0x hex
+  unsigned int address = 0;
+  size_t       i       = 0;
+  unsigned int base    = 10;
+
+  if ((len > 2) && (target[0] == '0') && ((target[1] == 'x') || (target[1] == 'X')))
+  {
+    base = 16;
+    i    = 2;
+  }
+  if (i >= len) return false;
+  for (; i < len; i++)
+  {
+    char c = tolower(target[i]);
+    unsigned int digit;
+
+    if ((c >= '0') && (c <= '9')) digit = c - '0';
+    else if ((base == 16) && (c >= 'a') && (c <= 'f')) digit = c - 'a' + 10;
+    else return false;
+    address = address * base + digit;
+    if (address > 0x7F) return false;
+  }
+  return address == e.ise->_address;
+}
+
+// does the probe's batch wait on this conversion; *parameter gets the
+// argument of the command that does, NAN when it has none
+bool uFire_ISE_RouterBase::_waits(const entry_t &e, uint8_t conversion, const char *request, const char *end, float *parameter)
+{
+  const char *cmd;
+  const char *argument;
+  size_t      cmd_len;
+  size_t      argument_len;
+
+  _commands = e.commands;
+  for (const char *p = request; _next(&p, end, &cmd, &cmd_len, &argument, &argument_len);)
+  {
+    const ise_command_t *c = _find(cmd, cmd_len);
+
+    if (c && (c->conversion == conversion))
+    {
+      *parameter = argument_len ? _to_float(argument, argument_len) : NAN;
+      return true;
+    }
+  }
+  return false;
+}
+
+void uFire_ISE_RouterBase::_collect(uint8_t conversion, const char *request, const char *end)
+{
+  uFire_ISEGroup group;
+
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    const entry_t &e = _entries[i];
+    float parameter;
+
+    if (!_waits(e, conversion, request, end, &parameter)) continue;
+    if ((e.type == ISE_PROBE_PH) && (conversion == ISE_MEASURE_MV))
+    {
+      // what measurepH() would set before converting
+      uFire_pH *ph = static_cast<uFire_pH *>(e.ise);
+
+      ph->useTemperatureCompensation(true);
+      ph->_temp = isnan(parameter) ? 25 : parameter;
+    }
+    group.add(e.ise);
+  }
+
+  // the group shares one conversion window between the probes
+  if (!group.size()) return;
+  if (conversion == ISE_MEASURE_MV) group.measuremV();
+  else group.measureTemp();
+}
+
+bool uFire_ISE_RouterBase::_route(JsonObject doc, const char *request, size_t len)
+{
+  const char *end    = request + len;
+  const char *colon  = (const char *)memchr(request, ':', len);
+  const char *target = nullptr;
+  size_t      target_len = 0;
+  bool        found  = false;
+
+  if (colon)
+  {
+    target_len = _token(&request, colon, &target);
+    request    = colon + 1;
+  }
+
+  bool all = (target_len == 1) && (*target == '*');
+
+  if (all)
+  {
+    _collect(ISE_MEASURE_MV, request, end);
+    _collect(ISE_MEASURE_TEMP, request, end);
+  }
+
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    const entry_t &e = _entries[i];
+
+    if (!colon && (i > 0)) break;
+    if (colon && !all && !_match(e, target, target_len)) continue;
+
+    const char *key   = e.name ? e.name : e.label;
+    JsonObject  probe = doc.createNestedObject(key);
+
+    _begin(e.ise, e.commands);
+    if (_run(probe, request, end - request, all)) found = true;
+    else doc.remove(key);
+  }
+
+  if (!found) value = -1;
+  return found;
+}
+
+#endif // if defined(ISE_COMMAND_AVAILABLE)
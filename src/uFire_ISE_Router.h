@@ -0,0 +1,101 @@
+#pragma once
+
+#include "uFire_ISE_Command.h"
+#include "uFire_ISEGroup.h"
+
+#if defined(ISE_COMMAND_AVAILABLE)
+
+#ifndef ISE_ROUTER_MAX
+# define ISE_ROUTER_MAX 16          /*!< most probes one router can address */
+#endif // ifndef ISE_ROUTER_MAX
+
+#ifndef ISE_ROUTER_OUTPUT_SIZE
+# define ISE_ROUTER_OUTPUT_SIZE 512 /*!< bytes for one response from process(String) */
+#endif // ifndef ISE_ROUTER_OUTPUT_SIZE
+
+// One command frontend for several probes on the bus. A request is
+// "target:commands", where target is an I2C address ("63" or "0x3f"), a
+// name given to add(), or '*' for every probe; without a target the first
+// probe added answers. Each probe answers in its own nested object,
+// {"0x3f":{"ph":7.01},"orp":{"o":230.5}}, keyed by name or address.
+//
+// For '*' the probes whose batch waits on a conversion are measured as one
+// uFire_ISEGroup, so N probes take one conversion time instead of N. Probes
+// are begun by the caller with their own addresses before add(); each
+// address can be added once.
+class uFire_ISE_RouterBase : public uFire_ISE_CommandBase
+{
+public:
+  bool    add(uFire_ISE  *ise,
+              const char *name=nullptr);
+  bool    add(uFire_pH   *ph,
+              const char *name=nullptr);
+  bool    add(uFire_ORP  *orp,
+              const char *name=nullptr);
+  uint8_t size();
+
+protected:
+  enum { ISE_PROBE_MV, ISE_PROBE_PH, ISE_PROBE_ORP };
+
+  typedef struct entry_t         /*! one probe in the registry */
+  {
+    uFire_ISE           *ise;
+    uint8_t              type;     /*!< ISE_PROBE_* */
+    const ise_command_t *commands;
+    const char          *name;     /*!< optional, the response key when set */
+    char                 label[5]; /*!< "0x3f", the response key otherwise */
+  } entry_t;
+
+  entry_t _entries[ISE_ROUTER_MAX];
+  uint8_t _count = 0;
+  bool    _add(uFire_ISE           *ise,
+               uint8_t              type,
+               const ise_command_t *commands,
+               const char          *name);
+  bool    _route(JsonObject  doc,
+                 const char *request,
+                 size_t      len);
+  bool    _match(const entry_t &e,
+                 const char    *target,
+                 size_t         len);
+  bool    _waits(const entry_t &e,
+                 uint8_t        conversion,
+                 const char    *request,
+                 const char    *end,
+                 float         *parameter);
+  void    _collect(uint8_t     conversion,
+                   const char *request,
+                   const char *end);
+};
+
+template<class Codec>
+class uFire_ISE_Router : public uFire_ISE_RouterBase
+{
+public:
+  size_t process(const char *request, size_t len, char *output, size_t size)
+  {
+    if (!_route(_doc.template to<JsonObject>(), request, len))
+    {
+      if (size) output[0] = '\0';
+      return 0;
+    }
+    return Codec::write(_doc, output, size);
+  }
+
+  String process(String request)
+  {
+    char output[ISE_ROUTER_OUTPUT_SIZE];
+
+    return _to_string(output, process(request.c_str(), request.length(), output, sizeof(output)));
+  }
+
+private:
+  // a member rather than a local, a full fan-out is too large for the stack
+  StaticJsonDocument<JSON_OBJECT_SIZE(ISE_ROUTER_MAX) +
+                     ISE_ROUTER_MAX * JSON_OBJECT_SIZE(ISE_COMMAND_BATCH_MAX)> _doc;
+};
+
+typedef uFire_ISE_Router<ise_json_codec>    uFire_ISE_Router_JSON;
+typedef uFire_ISE_Router<ise_msgpack_codec> uFire_ISE_Router_MP;
+
+#endif // if defined(ISE_COMMAND_AVAILABLE)
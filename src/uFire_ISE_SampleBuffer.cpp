@@ -0,0 +1,81 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "uFire_ISE_SampleBuffer.h"
+
+#if (ISE_SAMPLE_BUFFER_SIZE & (ISE_SAMPLE_BUFFER_SIZE - 1)) || (ISE_SAMPLE_BUFFER_SIZE > 128)
+# error "ISE_SAMPLE_BUFFER_SIZE must be a power of two no larger than 128"
+#endif // if (ISE_SAMPLE_BUFFER_SIZE & (ISE_SAMPLE_BUFFER_SIZE - 1)) || (ISE_SAMPLE_BUFFER_SIZE > 128)
+
+// Producer and consumer share one core, the producer at most in interrupt
+// context, so ordering only has to survive the compiler. A hardware fence
+// is a libcall on ARMv6-M toolchains (SAMD21) and may not link there; it is
+// only used where the two sides can run on different cores.
+#if defined(ARDUINO_ARCH_ESP32)
+# define ISE_SAMPLE_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else // if defined(ARDUINO_ARCH_ESP32)
+# define ISE_SAMPLE_BARRIER() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif // if defined(ARDUINO_ARCH_ESP32)
+
+bool uFire_ISE_SampleBuffer::push(const ise_sample_t &sample)
+{
+  uint8_t head = _head;
+
+  if ((uint8_t)(head - _tail) >= ISE_SAMPLE_BUFFER_SIZE)
+  {
+    overruns++;
+    return false;
+  }
+
+  _samples[head & (ISE_SAMPLE_BUFFER_SIZE - 1)] = sample;
+
+  // the record must be complete before the consumer can see it
+  ISE_SAMPLE_BARRIER();
+  _head = head + 1;
+  return true;
+}
+
+size_t uFire_ISE_SampleBuffer::drain(ise_sample_t *out, size_t max)
+{
+  uint8_t tail = _tail;
+  uint8_t n    = _head - tail;
+  size_t  i    = 0;
+
+  ISE_SAMPLE_BARRIER();
+  while ((i < n) && (i < max))
+  {
+    out[i] = _samples[(uint8_t)(tail + i) & (ISE_SAMPLE_BUFFER_SIZE - 1)];
+    i++;
+  }
+
+  // copies must finish before the slots are handed back to the producer
+  ISE_SAMPLE_BARRIER();
+  _tail = tail + i;
+  return i;
+}
+
+size_t uFire_ISE_SampleBuffer::available()
+{
+  return (uint8_t)(_head - _tail);
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2020 Justin Decker
+
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef ISE_SAMPLEBUFFER_H
+#define ISE_SAMPLEBUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef ISE_SAMPLE_BUFFER_SIZE
+# define ISE_SAMPLE_BUFFER_SIZE 32 /*!< records per buffer, a power of two no larger than 128 */
+#endif // ifndef ISE_SAMPLE_BUFFER_SIZE
+
+typedef struct ise_sample_t     /*! one timestamped measurement */
+{
+  uint32_t timestamp_us; /*!< micros() when the result was read */
+  float    mV;           /*!< mV of probe */
+  float    tempC;        /*!< last temperature in C */
+  float    derived;      /*!< pH, Eh, or NAN for a raw ISE probe */
+} ise_sample_t;
+
+class uFire_ISE_SampleBuffer    /*! lock-free single-producer/single-consumer ring */
+{
+public:
+
+  uint32_t overruns = 0; /*!< records dropped because the buffer was full */
+  bool     push(const ise_sample_t &sample);
+  size_t   drain(ise_sample_t *out,
+                 size_t        max);
+  size_t   available();
+
+private:
+
+  // free running 8-bit indices are atomic to load and store everywhere,
+  // including AVR; each is written by only one side
+  ise_sample_t     _samples[ISE_SAMPLE_BUFFER_SIZE];
+  volatile uint8_t _head = 0;
+  volatile uint8_t _tail = 0;
+};
+
+#endif // ifndef ISE_SAMPLEBUFFER_H
@@ -23,12 +23,23 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "uFire_ORP.h"
+#include "uFire_ISE_Convert.h"
+
+bool uFire_ORP::begin(uint8_t address, TwoWire &wirePort)
+{
+  _potential_valid = false;
+  if (!uFire_ISE::begin(address, wirePort)) return false;
+
+  refreshProbePotential();
+  return true;
+}
 
 float uFire_ORP::measureORP()
 {
+  ISE_STAT_CALL(ISE_CALL_MEASURE_ORP);
   measuremV();
   ORP = mV;
-  Eh  = mV + getProbePotential();
+  Eh  = ise_convert_Eh(mV, getProbePotential());
 
   if (isinf(ORP)) {
     mV  = -1;
@@ -47,7 +58,7 @@ float uFire_ORP::measureORP()
 void uFire_ORP::readData()
 {
   ORP = mV;
-  Eh  = mV + getProbePotential();
+  Eh  = ise_convert_Eh(mV, getProbePotential());
 
   if (isinf(ORP)) {
     mV  = -1;
@@ -59,14 +70,36 @@ void uFire_ORP::readData()
     ORP = -1;
     Eh  = -1;
   }
+  _derived = Eh;
+}
+
+void uFire_ORP::startMeasureORP()
+{
+  startMeasuremV();
+}
+
+void uFire_ORP::_measured()
+{
+  readData();
 }
 
 void uFire_ORP::setProbePotential(uint32_t potential)
 {
   writeEEPROM(POTENTIAL_REGISTER_ADDRESS, potential);
+  _potential       = potential;
+  _potential_valid = true;
 }
 
 uint32_t uFire_ORP::getProbePotential()
 {
-  return readEEPROM(POTENTIAL_REGISTER_ADDRESS);
+  if (!_potential_valid) return refreshProbePotential();
+
+  return _potential;
+}
+
+uint32_t uFire_ORP::refreshProbePotential()
+{
+  _potential       = readEEPROM(POTENTIAL_REGISTER_ADDRESS);
+  _potential_valid = true;
+  return _potential;
 }
@@ -36,10 +36,23 @@ public:
   float ORP;
   float Eh;
 
+  bool     begin(uint8_t  address=ISE_PROBE_I2C,
+                 TwoWire &wirePort=Wire);
   float    measureORP();
   void     setProbePotential(uint32_t potential);
   uint32_t getProbePotential();
+  uint32_t refreshProbePotential();
   void     readData();
+  void     startMeasureORP();
+
+protected:
+
+  void     _measured();
+
+private:
+
+  uint32_t _potential;
+  bool     _potential_valid = false;
 };
 
 class ISE_ORP : public uFire_ORP{
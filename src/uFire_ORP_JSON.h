@@ -1,22 +1,13 @@
 #pragma once
 
-#include <uFire_ORP.h>
+#include "uFire_ISE_Command.h"
 
-class uFire_ORP_JSON
+#if defined(ISE_COMMAND_AVAILABLE)
+class uFire_ORP_JSON : public uFire_ISE_Command<uFire_ORP, ise_json_codec>
 {
 public:
-  float value;
-  String emptyPlaceholder;
   uFire_ORP_JSON(){}
-  void begin(ISE_ORP *orp);
-  String processJSON(String json);
-private:
-  ISE_ORP *orp;
-  String orp_reset();
-  String orp_connected();
-  String orp_measure();
-  String orp_offset(String);
-  String orp_potential(String);
-  String orp_temp();
+  String processJSON(String request) { return process(request); }
+  size_t processJSON(const char *request, size_t len, char *output, size_t size) { return process(request, len, output, size); }
 };
-
+#endif // if defined(ISE_COMMAND_AVAILABLE)
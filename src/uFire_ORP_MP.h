@@ -1,22 +1,13 @@
 #pragma once
 
-#include <uFire_ORP.h>
+#include "uFire_ISE_Command.h"
 
-class uFire_ORP_MP
+#if defined(ISE_COMMAND_AVAILABLE)
+class uFire_ORP_MP : public uFire_ISE_Command<uFire_ORP, ise_msgpack_codec>
 {
 public:
-  float value;
-  String emptyPlaceholder;
   uFire_ORP_MP(){}
-  void begin(uFire_ORP *orp);
-  String processMP(String json);
-private:
-  uFire_ORP *orp;
-  String orp_reset();
-  String orp_connected();
-  String orp_measure();
-  String orp_offset(String);
-  String orp_potential(String);
-  String orp_temp();
+  String processMP(String request) { return process(request); }
+  size_t processMP(const char *request, size_t len, char *output, size_t size) { return process(request, len, output, size); }
 };
-
+#endif // if defined(ISE_COMMAND_AVAILABLE)
@@ -23,77 +23,203 @@
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "uFire_pH.h"
+#include "uFire_ISE_Convert.h"
+
+// pH per mV at ISE_NERNST_TEMP_MIN + i * ISE_NERNST_TEMP_STEP
+static constexpr float _nernst_gain(int i)
+{
+  return 298.15 / (PROBE_MV_TO_PH * (273.15 + ISE_NERNST_TEMP_MIN + i * ISE_NERNST_TEMP_STEP));
+}
+
+static const float _nernst_table[ISE_NERNST_TABLE_SIZE] = {
+  _nernst_gain(0),  _nernst_gain(1),  _nernst_gain(2),  _nernst_gain(3),  _nernst_gain(4),
+  _nernst_gain(5),  _nernst_gain(6),  _nernst_gain(7),  _nernst_gain(8),  _nernst_gain(9),
+  _nernst_gain(10), _nernst_gain(11), _nernst_gain(12), _nernst_gain(13), _nernst_gain(14),
+  _nernst_gain(15), _nernst_gain(16), _nernst_gain(17), _nernst_gain(18), _nernst_gain(19),
+  _nernst_gain(20)
+};
 
 float uFire_pH::_measure(float temp)
 {
+  if (_nernst)
+  {
+    // the firmware has already mapped mV through the calibration, whose
+    // references were written at the slope for their temperature
+    pH  = (mV == -1) ? -1 : 7 - mV * _nernstGain(temp);
+    pOH = fabs(pH - 14);
+
+    if ((pH <= 0.0) || (pH > 14.0) || isinf(pH) || isnan(pH))
+    {
+      pH  = -1;
+      pOH = -1;
+    }
+    _derived = pH;
+    return pH;
+  }
+
+#if defined(ISE_FIXED_POINT)
+  return _measureFixed(temp);
+#else // if defined(ISE_FIXED_POINT)
   // Turn mV into pH
-  float mv = mV;
+  pH  = ise_convert_pH(mV, temp);
+  pOH = (pH == -1) ? -1 : fabs(pH - 14);
+  _derived = pH;
 
-  if (mv == -1)
+  return pH;
+#endif // if defined(ISE_FIXED_POINT)
+}
+
+float uFire_pH::_measureFixed(float temp)
+{
+  // same steps as _measure(), in ISE_FIXED_MV_SCALE/ISE_FIXED_PH_SCALE units;
+  // the range check also keeps the float to int conversions defined
+  if ((mV == -1) || !(fabs(mV) < 20000) || !(fabs(temp) < 1000))
   {
-    pH  = -1;
-    pOH = -1;
+    pH       = -1;
+    pOH      = -1;
+    _derived = -1;
     return -1;
   }
 
-  pH = fabs(7.0 - (mv / PROBE_MV_TO_PH));
+  int32_t mv  = (int32_t)(mV * ISE_FIXED_MV_SCALE + (mV < 0 ? -0.5 : 0.5));
+  int32_t t   = (int32_t)(temp * 100 + (temp < 0 ? -0.5 : 0.5));
+  int32_t ph  = mVtopHFixed(mv);
+  int32_t rph = (ph + ISE_FIXED_PH_SCALE / 2) / ISE_FIXED_PH_SCALE;
+  int32_t rt  = (t >= 0) ? (t + 50) / 100 : -((-t + 50) / 100);
 
   // Determine the temperature correction
-  uint8_t distance_from_7  = abs(7 - round(pH));
-  uint8_t distance_from_25 = floor(abs(25 - round(temp)) / 10);
-  float   temp_multiplier  = (distance_from_25 * distance_from_7) * TEMP_CORRECTION_FACTOR;
-  if ((pH >= 8.0) && (temp >= 35))
-  {
-    // negative
-    temp_multiplier *= -1;
-  }
-  if ((pH <= 6.0) && (temp <= 15))
-  {
-    // negative
-    temp_multiplier *= -1;
-  }
-  pH += temp_multiplier;
+  int32_t distance_from_7  = rph > 7 ? rph - 7 : 7 - rph;
+  int32_t distance_from_25 = (rt > 25 ? rt - 25 : 25 - rt) / 10;
+  int32_t temp_multiplier  = distance_from_25 * distance_from_7 * ISE_FIXED_TEMP_CORRECTION;
 
-  pOH = fabs(pH - 14);
+  if ((ph >= 8 * ISE_FIXED_PH_SCALE) && (t >= 3500)) temp_multiplier = -temp_multiplier;
+  if ((ph <= 6 * ISE_FIXED_PH_SCALE) && (t <= 1500)) temp_multiplier = -temp_multiplier;
+  ph += temp_multiplier;
 
-  if ((pH <= 0.0) || (pH > 14.0)) {
-    pH  = -1;
-    pOH = -1;
-  }
-  if (isinf(pH)) {
+  if ((ph <= 0) || (ph > 14 * ISE_FIXED_PH_SCALE))
+  {
     pH  = -1;
     pOH = -1;
   }
-  if (isnan(pH)) {
-    pH  = -1;
-    pOH = -1;
+  else
+  {
+    int32_t poh = 14 * ISE_FIXED_PH_SCALE - ph;
+
+    pH  = ph * (1.0 / ISE_FIXED_PH_SCALE);
+    pOH = (poh < 0 ? -poh : poh) * (1.0 / ISE_FIXED_PH_SCALE);
   }
+  _derived = pH;
 
   return pH;
 }
 
 float uFire_pH::measurepH(float temp)
 {
+  ISE_STAT_CALL(ISE_CALL_MEASURE_PH);
   useTemperatureCompensation(true);  
+  _temp = temp;
   // Turn mV into pH
   measuremV();
-  _measure();
   return _measure(temp);
 }
 
+float uFire_pH::measurepHAdaptive(float tolerance, float temp, uint8_t max_samples)
+{
+  ISE_STAT_CALL(ISE_CALL_MEASURE_PH);
+  useTemperatureCompensation(true);
+  _temp = temp;
+  measuremVAdaptive(tolerance * nernstSlope(temp), max_samples);
+  pHUncertainty = uncertainty / nernstSlope(temp);
+  return _measure(temp);
+}
+
+void uFire_pH::startMeasurepH(float temp)
+{
+  useTemperatureCompensation(true);
+  _temp = temp;
+  startMeasuremV();
+}
+
+void uFire_pH::_measured()
+{
+  _measure(_temp);
+}
 
 void uFire_pH::readData()
 {
   _measure();
 }
 
+void uFire_pH::useNernstSlope(bool b)
+{
+  _nernst = b;
+}
+
+bool uFire_pH::usingNernstSlope()
+{
+  return _nernst;
+}
+
+float uFire_pH::nernstSlope(float temp)
+{
+  // mV per pH; PROBE_MV_TO_PH unless useNernstSlope() is on
+  return _nernst ? 1 / _nernstGain(temp) : PROBE_MV_TO_PH;
+}
+
+float uFire_pH::_nernstGain(float temp)
+{
+  float x = (temp - ISE_NERNST_TEMP_MIN) * (1.0f / ISE_NERNST_TEMP_STEP);
+
+  if (!(x > 0)) return _nernst_table[0];
+  if (x >= ISE_NERNST_TABLE_SIZE - 1) return _nernst_table[ISE_NERNST_TABLE_SIZE - 1];
+
+  uint8_t i = x;
+
+  return _nernst_table[i] + (_nernst_table[i + 1] - _nernst_table[i]) * (x - i);
+}
+
 float uFire_pH::pHtomV(float pH)
 {
+  // in Nernst mode, at the temperature of the last measurement; calibrating
+  // after measurepH(temp) in the solution writes references at its slope
+  if (_nernst) return (7 - pH) / _nernstGain(_temp);
+#if defined(ISE_FIXED_POINT)
+  // outside this range, or NaN, the scaled value would overflow int32
+  if (fabs(pH) < 1000)
+  {
+    return pHtomVFixed(pH * ISE_FIXED_PH_SCALE + (pH < 0 ? -0.5 : 0.5)) * (1.0 / ISE_FIXED_MV_SCALE);
+  }
+#endif // if defined(ISE_FIXED_POINT)
   return (7 - pH) * PROBE_MV_TO_PH;
 }
 
+int32_t uFire_pH::pHtomVFixed(int32_t pH)
+{
+  // pH in ISE_FIXED_PH_SCALE units to mV in ISE_FIXED_MV_SCALE units, rounded
+  int32_t n = (7 * ISE_FIXED_PH_SCALE - pH) * (ISE_FIXED_MV_TO_PH / 10);
+
+  return (n >= 0 ? n + 50 : n - 50) / 100;
+}
+
+int32_t uFire_pH::mVtopHFixed(int32_t mV)
+{
+  // mV in ISE_FIXED_MV_SCALE units to pH in ISE_FIXED_PH_SCALE units, rounded
+  int32_t n  = mV * ISE_FIXED_PH_SCALE;
+  int32_t q  = (n >= 0 ? n + ISE_FIXED_MV_TO_PH / 2 : n - ISE_FIXED_MV_TO_PH / 2) / ISE_FIXED_MV_TO_PH;
+  int32_t ph = 7 * ISE_FIXED_PH_SCALE - q;
+
+  return ph < 0 ? -ph : ph;
+}
+
 float uFire_pH::mVtopH(float mV)
 {
+  if (_nernst) return 7 - mV * _nernstGain(_temp);
+#if defined(ISE_FIXED_POINT)
+  if (fabs(mV) < 20000)
+  {
+    return mVtopHFixed(mV * ISE_FIXED_MV_SCALE + (mV < 0 ? -0.5 : 0.5)) * (1.0 / ISE_FIXED_PH_SCALE);
+  }
+#endif // if defined(ISE_FIXED_POINT)
   return fabs(7.0 - (mV / PROBE_MV_TO_PH));
 }
 
@@ -111,6 +237,27 @@ float uFire_pH::calibrateProbeLow(float solutionpH)
   return mVtopH(uFire_ISE::getCalibrateLowReading());
 }
 
+float uFire_pH::calibrateSingleWhenStable(float solutionpH, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateSingle(solutionpH);
+}
+
+float uFire_pH::calibrateProbeLowWhenStable(float solutionpH, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateProbeLow(solutionpH);
+}
+
+float uFire_pH::calibrateProbeHighWhenStable(float solutionpH, unsigned long timeout, float slope, float noise)
+{
+  if (!waitStable(timeout, slope, noise)) return NAN;
+
+  return calibrateProbeHigh(solutionpH);
+}
+
 float uFire_pH::getCalibrateLowReference()
 {
   return mVtopH(uFire_ISE::getCalibrateLowReference());
@@ -27,30 +27,81 @@
 
 #include <math.h>
 #include "uFire_ISE.h"
+#include "uFire_ISE_Constants.h"
 
-#define PROBE_MV_TO_PH 59.2
-#define TEMP_CORRECTION_FACTOR 0.03
+// Define ISE_FIXED_POINT to compute pH in scaled int32 arithmetic instead of
+// soft-float on MCUs without an FPU. mV is taken in hundredths of a mV and
+// temperature in hundredths of a degree; pH and pOH are carried in
+// thousandths, so results are within 0.001 pH of the float path, except
+// right at a rounding edge of the temperature correction buckets or the
+// 0-14 range check, where the two paths can land on different sides.
+#define ISE_FIXED_MV_SCALE 100         /*!< fixed point mV units per mV */
+#define ISE_FIXED_PH_SCALE 1000        /*!< fixed point pH units per pH */
+#define ISE_FIXED_MV_TO_PH 5920        /*!< PROBE_MV_TO_PH in fixed point mV */
+#define ISE_FIXED_TEMP_CORRECTION 30   /*!< TEMP_CORRECTION_FACTOR in fixed point pH */
+
+// useNernstSlope() replaces the bucketed TEMP_CORRECTION_FACTOR correction with
+// a slope proportional to absolute temperature, PROBE_MV_TO_PH at 25 C. The
+// reciprocal slope is tabulated at compile time and interpolated, so each
+// sample costs one multiply-add and no division; interpolation stays within
+// 0.001 pH of the exact slope from 0 to 100 C. Nernst mode is always float,
+// even with ISE_FIXED_POINT.
+#define ISE_NERNST_TEMP_MIN 0          /*!< C, first table entry; colder is clamped */
+#define ISE_NERNST_TEMP_STEP 5         /*!< C between table entries */
+#define ISE_NERNST_TABLE_SIZE 21       /*!< entries, up to 100 C; hotter is clamped */
 
 class uFire_pH : public uFire_ISE {
+  friend class uFire_ISE_RouterBase;
+
 public:
 
   float pH;
   float pOH;  
+  float pHUncertainty; /*!< standard error of pH from measurepHAdaptive() */
   float measurepH(float temp=25);
+  float measurepHAdaptive(float   tolerance,
+                          float   temp=25,
+                          uint8_t max_samples=ISE_FILTER_SIZE);
+  void  useNernstSlope(bool b);
+  bool  usingNernstSlope();
+  float nernstSlope(float temp);
   float pHtomV(float pH);
   float mVtopH(float mV);
+  int32_t pHtomVFixed(int32_t pH);
+  int32_t mVtopHFixed(int32_t mV);
   float calibrateSingle(float solutionpH);
   float calibrateProbeLow(float solutionpH);
   float getCalibrateLowReference();
   float getCalibrateLowReading();
   float calibrateProbeHigh(float solutionpH);
+  float calibrateSingleWhenStable(float         solutionpH,
+                                  unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                  float         slope=ISE_STABLE_SLOPE,
+                                  float         noise=ISE_STABLE_NOISE);
+  float calibrateProbeLowWhenStable(float         solutionpH,
+                                    unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                    float         slope=ISE_STABLE_SLOPE,
+                                    float         noise=ISE_STABLE_NOISE);
+  float calibrateProbeHighWhenStable(float         solutionpH,
+                                     unsigned long timeout=ISE_STABLE_TIMEOUT,
+                                     float         slope=ISE_STABLE_SLOPE,
+                                     float         noise=ISE_STABLE_NOISE);
   float getCalibrateHighReference();
   float getCalibrateHighReading();
   void  readData();
+  void  startMeasurepH(float temp=25);
+
+protected:
+
+  void  _measured();
 
 private:
 
+  float _temp   = 25;
+  bool  _nernst = false;
   float _measure(float temp=25);
+  float _nernstGain(float temp);
+  float _measureFixed(float temp);
   void  _updateRegisters();
 };
 
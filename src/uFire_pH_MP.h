@@ -1,25 +1,13 @@
 #pragma once
 
-#include <uFire_pH.h>
+#include "uFire_ISE_Command.h"
 
-class uFire_pH_MP
+#if defined(ISE_COMMAND_AVAILABLE)
+class uFire_pH_MP : public uFire_ISE_Command<uFire_pH, ise_msgpack_codec>
 {
 public:
-  float value;
-  String emptyPlaceholder;
   uFire_pH_MP(){}
-  void begin(uFire_pH *ph);
-  String processMP(String json);
-private:
-  uFire_pH *ph;
-  String ph_reset();
-  String ph_connected();
-  String ph_single(String);
-  String ph_high_ref(String);
-  String ph_high_read();
-  String ph_low_ref(String);
-  String ph_low_read();
-  String ph_measure(String);
-  String ph_temp();
+  String processMP(String request) { return process(request); }
+  size_t processMP(const char *request, size_t len, char *output, size_t size) { return process(request, len, output, size); }
 };
-
+#endif // if defined(ISE_COMMAND_AVAILABLE)